@@ -16,6 +16,7 @@
 #include "Constants.h"
 
 const char* msg::IOT_EVENT = "IOT_EVENT";
+const char* msg::IOT_EVENT_BATCH = "IOT_EVENT_BATCH";
 const char* msg::SIM_EVENT = "SIM_EVENT";
 const char* msg::EG_TIMEOUT = "EG_TIMEOUT";
 const char* msg::SE_TIMEOUT = "SE_TIMEOUT";
@@ -23,6 +23,8 @@ namespace msg {
      */
     // physical operation event
     extern const char* IOT_EVENT;
+    // physical operation events of one generation tick
+    extern const char* IOT_EVENT_BATCH;
     // virtual operation event
     extern const char* SIM_EVENT;
     /*
@@ -36,5 +38,14 @@ namespace msg {
     extern const char* SC_TIMEOUT;
 }
 
+// initialization stages of the modules
+namespace initStage {
+    // the Logger is configured for the whole network, before any module logs
+    const int LOGGING = 0;
+    // modules load their situation models and schedule their first events
+    const int MODELS = 1;
+    const int COUNT = 2;
+}
+
 
 #endif /* CONSTANTS_H_ */
@@ -0,0 +1,152 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <iostream>
+#include "Logger.h"
+
+int Logger::threshold = LOG_LEVEL_INFO;
+
+Logger::Logger() : ring(CAPACITY) {
+    head = 0;
+    size = 0;
+    writing = 0;
+    async = false;
+    stopping = false;
+}
+
+Logger::~Logger() {
+    _stop();
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Record::Record() {
+}
+
+std::ostream& Logger::Record::stream() {
+    return message;
+}
+
+Logger::Record::~Record() {
+    std::string line = message.str();
+    if (line.empty() || line.back() != '\n') {
+        line += '\n';
+    }
+    instance()._write(line);
+}
+
+int Logger::parseLevel(const std::string &name) {
+    static const char *names[] = { "trace", "debug", "info", "warn", "error", "off" };
+    for (int level = LOG_LEVEL_TRACE; level <= LOG_LEVEL_OFF; level++) {
+        if (name == names[level]) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+void Logger::setLevel(int level) {
+    threshold = level;
+}
+
+void Logger::setAsync(bool async) {
+    Logger &logger = instance();
+    if (!async) {
+        logger._stop();
+        return;
+    }
+    std::lock_guard<std::mutex> guard(logger.lock);
+    if (!logger.async) {
+        logger.async = true;
+        logger.writer = std::thread(&Logger::_run, &logger);
+    }
+}
+
+void Logger::flush() {
+    Logger &logger = instance();
+    std::unique_lock<std::mutex> guard(logger.lock);
+    logger.drained.wait(guard, [&logger] {
+        return logger.size == 0 && logger.writing == 0;
+    });
+    std::cout.flush();
+}
+
+void Logger::_write(std::string &line) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (!async) {
+        std::cout << line;
+        return;
+    }
+
+    /*
+     * The simulation only waits for the writer if the ring buffer is full
+     */
+    notFull.wait(guard, [this] { return size < CAPACITY; });
+    ring[(head + size) % CAPACITY].swap(line);
+    // the writer only waits for an empty ring buffer
+    if (size++ == 0) {
+        notEmpty.notify_one();
+    }
+}
+
+void Logger::_run() {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        notEmpty.wait(guard, [this] { return size > 0 || stopping; });
+        if (size == 0) {
+            break;
+        }
+
+        /*
+         * Take every buffered record at once and write them without holding the lock
+         */
+        batch.resize(size);
+        for (size_t k = 0; k < size; k++) {
+            batch[k].swap(ring[(head + k) % CAPACITY]);
+        }
+        head = (head + size) % CAPACITY;
+        writing = size;
+        size = 0;
+        notFull.notify_all();
+        guard.unlock();
+
+        for (auto &line : batch) {
+            std::cout.write(line.data(), line.size());
+        }
+
+        guard.lock();
+        writing = 0;
+        drained.notify_all();
+    }
+}
+
+void Logger::_stop() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!async) {
+            return;
+        }
+        stopping = true;
+        notEmpty.notify_one();
+    }
+    // the writer drains the ring buffer before it stops
+    writer.join();
+    async = false;
+    stopping = false;
+}
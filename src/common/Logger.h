@@ -0,0 +1,116 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef COMMON_LOGGER_H_
+#define COMMON_LOGGER_H_
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*
+ * log levels, from the most to the least verbose
+ */
+// every IoT event, simulation event, evidence and state change
+#define LOG_LEVEL_TRACE 0
+// every evolution cycle: triggered situations, generated operations, event queues
+#define LOG_LEVEL_DEBUG 1
+// progress of the simulation, e.g., time slices
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5
+
+// records below this level are not even compiled, e.g., -DLOG_COMPILE_LEVEL=LOG_LEVEL_INFO
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#endif
+
+/*
+ * Leveled logging to the standard output. The message of a record is only formatted if
+ * its level is enabled, both at compile time and at run time. Formatted records are
+ * written synchronously, or, if enabled with setAsync, by a background thread from a
+ * bounded ring buffer, so that the simulation does not wait for the console.
+ */
+class Logger {
+public:
+    /*
+     * One record, written as a line once complete
+     */
+    class Record {
+    private:
+        std::ostringstream message;
+    public:
+        Record();
+        std::ostream& stream();
+        virtual ~Record();
+    };
+
+    static bool isEnabled(int level) {
+        return level >= threshold;
+    }
+    // return the level of "trace", "debug", "info", "warn", "error" or "off", or -1
+    static int parseLevel(const std::string &name);
+    static void setLevel(int level);
+    // write records synchronously, or through the background writer
+    static void setAsync(bool async);
+    // return once every record so far is written
+    static void flush();
+private:
+    static int threshold;
+
+    // ring buffer of formatted records
+    static const size_t CAPACITY = 4096;
+    std::vector<std::string> ring;
+    size_t head;
+    size_t size;
+    // number of records taken by the writer and not written yet
+    size_t writing;
+    bool async;
+    bool stopping;
+    std::mutex lock;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::condition_variable drained;
+    std::thread writer;
+
+    Logger();
+    static Logger& instance();
+    void _write(std::string &line);
+    void _run();
+    void _stop();
+public:
+    virtual ~Logger();
+};
+
+#define LOG_ENABLED(level) ((level) >= LOG_COMPILE_LEVEL && Logger::isEnabled(level))
+// the message is a stream expression, e.g., LOG_DEBUG("node " << id << " reset")
+#define LOG_AT(level, message) \
+    do { \
+        if (LOG_ENABLED(level)) { \
+            Logger::Record _record; \
+            _record.stream() << message; \
+        } \
+    } while (0)
+#define LOG_TRACE(message) LOG_AT(LOG_LEVEL_TRACE, message)
+#define LOG_DEBUG(message) LOG_AT(LOG_LEVEL_DEBUG, message)
+#define LOG_INFO(message) LOG_AT(LOG_LEVEL_INFO, message)
+#define LOG_WARN(message) LOG_AT(LOG_LEVEL_WARN, message)
+#define LOG_ERROR(message) LOG_AT(LOG_LEVEL_ERROR, message)
+
+#endif /* COMMON_LOGGER_H_ */
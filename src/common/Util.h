@@ -30,70 +30,70 @@ namespace util {
  * Template function to print vectors of any type
  */
 template <typename T>
-void printVector(const vector<T>& vec) {
+void printVector(const vector<T>& vec, ostream& os = cout) {
     for (const T &element : vec) {
         // Print each element followed by a space
-        cout << element << "  ";
+        os << element << "  ";
     }
     // Newline after printing the vector
-    cout << endl;
+    os << endl;
 }
 
 /*
  * Template function to print a set of any type
  */
 template <typename T>
-void printSet(const set<T>& s) {
+void printSet(const set<T>& s, ostream& os = cout) {
     for (const T& element : s) {
-        cout << element << "  ";
+        os << element << "  ";
     }
-    cout << endl;
+    os << endl;
 }
 
 /*
  * Template function to print maps of any key-value types
  */
 template <typename K, typename V>
-void printMap(const map<K, V>& m) {
+void printMap(const map<K, V>& m, ostream& os = cout) {
     for (const auto& pair : m) {
-        cout << pair.first << ": " << pair.second << "  ";
+        os << pair.first << ": " << pair.second << "  ";
     }
-    cout << endl;
+    os << endl;
 }
 
 /*
  * Template function to print a stack of any type
  */
 template <typename T>
-void printStack(stack<T> s) {
+void printStack(stack<T> s, ostream& os = cout) {
     // Loop through the stack until it's empty
     while (!s.empty()) {
-        cout << s.top() << "  ";
+        os << s.top() << "  ";
         s.pop();
     }
-    cout << endl;
+    os << endl;
 }
 
 /*
  * Template function to print a queue of any type
  */
 template <typename T>
-void printQueue(queue<T> q) {
+void printQueue(queue<T> q, ostream& os = cout) {
     // Loop through the queue until it's empty
     while (!q.empty()) {
-        cout << q.front() << "  ";
+        os << q.front() << "  ";
         q.pop();
     }
-    cout << endl;
+    os << endl;
 }
 
 /*
  * Template function to print a container of vector, set, or their variants
  */
 template <typename T>
-void printContainer(const T& container) {
+void printContainer(const T& container, ostream& os = cout) {
     for (const auto& element : container) {
-        cout << element << "  ";
+        os << element << "  ";
     }
 }
 
@@ -101,13 +101,13 @@ void printContainer(const T& container) {
  * Template function to print a queue of any type that contains another container
  */
 template <typename T>
-void printComplexQueue(queue<T> q) {
+void printComplexQueue(queue<T> q, ostream& os = cout) {
     while (!q.empty()) {
         // Access the front element (which is a container)
         const T& container = q.front();
         // Print the container's elements
-        printContainer(container);
-        cout << endl;
+        printContainer(container, os);
+        os << endl;
         q.pop();
     }
 }
@@ -116,12 +116,12 @@ void printComplexQueue(queue<T> q) {
  * Template function to print a map where the value is a container
  */
 template <typename K, typename V>
-void printComplexMap(const map<K, V>& m) {
+void printComplexMap(const map<K, V>& m, ostream& os = cout) {
     for (const auto& pair : m) {
-        cout << pair.first << ": ";
+        os << pair.first << ": ";
         // Print the container stored as the value
-        printContainer(pair.second);
-        cout << endl;
+        printContainer(pair.second, os);
+        os << endl;
     }
 }
 
@@ -17,21 +17,16 @@
 #include "../common/Constants.h"
 #include "../objects/PhysicalOperation.h"
 #include "../messages/IoTEvent_m.h"
+#include "../messages/IoTEventBatch_m.h"
 #include "EventSource.h"
 
 Define_Module(EventSource);
 
 EventSource::EventSource(){
     MAX_TRIGGER_LIMIT = 4;
+    batchEvents = false;
     toltalOperations = 0;
     toltalSituations = 0;
-    /*
-     * Construct a situation graph and its instance
-     */
-//    sa.initModel("../files/SG.json");
-    sa.initModel("../files/SG2.json");
-
-//    sa.print();
 
     // 500 ms
     min_event_cycle = 0.5;
@@ -45,7 +40,24 @@ EventSource::~EventSource(){
     }
 }
 
-void EventSource::initialize() {
+int EventSource::numInitStages() const {
+    return initStage::COUNT;
+}
+
+void EventSource::initialize(int stage) {
+    if (stage != initStage::MODELS) {
+        return;
+    }
+
+    /*
+     * Construct a situation graph and its instance
+     */
+//    sa.initModel("../files/SG.json");
+    sa.initModel("../files/SG2.json");
+
+//    sa.print();
+
+    batchEvents = par("batchEvents").boolValue();
     // schedule IoT event generation
     scheduleAt(min_event_cycle, EGTimeout);
 }
@@ -64,42 +76,14 @@ void EventSource::handleMessage(cMessage *msg) {
         vector<PhysicalOperation> operations = sa.arrange(MAX_TRIGGER_LIMIT, current);
         int operationCount = operations.size();
         int situationCount = 0;
-        for(auto operation : operations){
-            IoTEvent* event = new IoTEvent(msg::IOT_EVENT);
-            long opID = operation.id;
-            event->setEventID(opID);
-            event->setToTrigger(operation.toTrigger);
-            event->setTimestamp(operation.timestamp);
-            event->setType(operation.type);
-            event->setCounter(operation.counter);
-
-            /*
-             * Check the explicit cause only
-             */
-//            vector<long> causes = sa.getModel().getNode(operation.id).causes;
-//            map<long, int> causeCounts;
-//            for(auto cause : causes){
-//                causeCounts[cause] = sa.getInstance(cause).counter;
-//            }
-            /*
-             * Check both explicit cause and implicit cause
-             */
-            vector<long> operations =
-                    sa.getModel().getAllOperationalSitutions();
-            map<long, int> causeCounts;
-            for (auto op2 : operations) {
-                if (op2 != opID && sa.getModel().isReachable(op2, opID)
-                        && !sa.getModel().isReachable(opID, op2)) {
-                    causeCounts[op2] = sa.getInstance(op2).counter;
-                }
+        if (batchEvents) {
+            sendBatch(operations);
+        } else {
+            for (auto &operation : operations) {
+                sendEvent(operation);
             }
-            json j_causeCounts(causeCounts);
-            event->setCauseCounts(j_causeCounts.dump().c_str());
-
-            simtime_t latency = lg.generator_latency();
-            // send out the message
-            sendDelayed(event, latency, "out");
-
+        }
+        for(auto &operation : operations){
             if(operation.toTrigger){
                 situationCount++;
             }
@@ -110,3 +94,104 @@ void EventSource::handleMessage(cMessage *msg) {
         scheduleAt(simTime() + min_event_cycle, EGTimeout);
     }
 }
+
+void EventSource::sendEvent(const PhysicalOperation &operation) {
+    IoTEvent* event = new IoTEvent(msg::IOT_EVENT);
+    long opID = operation.id;
+    event->setEventID(opID);
+    event->setToTrigger(operation.toTrigger);
+    event->setTimestamp(operation.timestamp);
+    event->setType(operation.type);
+    event->setCounter(operation.counter);
+
+    /*
+     * Check the explicit cause only
+     */
+//    vector<long> causes = sa.getModel().getNode(operation.id).causes;
+//    map<long, int> causeCounts;
+//    for(auto cause : causes){
+//        causeCounts[cause] = sa.getInstance(cause).counter;
+//    }
+    /*
+     * Check both explicit cause and implicit cause
+     * The causes are packed as dense situation indices, which the synchronizer
+     * resolves against the same shared model
+     */
+    const SituationGraph &sg = sa.getModel();
+    const vector<int> &causes = sg.getImplicitCauses(sg.indexOf(opID));
+    event->setCauseIndicesArraySize(causes.size());
+    event->setCauseCountersArraySize(causes.size());
+    for (size_t k = 0; k < causes.size(); k++) {
+        event->setCauseIndices(k, causes[k]);
+        event->setCauseCounters(k, sa.getInstanceAt(causes[k]).counter);
+    }
+
+    simtime_t latency = lg.generator_latency();
+    // send out the message
+    sendDelayed(event, latency, "out");
+}
+
+void EventSource::sendBatch(const vector<PhysicalOperation> &operations) {
+    if (operations.empty()) {
+        return;
+    }
+
+    /*
+     * 1. Draw the latency of every operation as if it were sent alone, and order the
+     * operations by arrival. Equal arrivals keep the order of generation, as they
+     * would in the future event set.
+     */
+    latencies.clear();
+    arrivalOrder.clear();
+    for (size_t k = 0; k < operations.size(); k++) {
+        latencies.push_back(lg.generator_latency());
+        arrivalOrder.push_back(k);
+    }
+    std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(),
+            [this](size_t a, size_t b) { return latencies[a] < latencies[b]; });
+
+    /*
+     * 2. Pack the operations together with their implicit causes
+     */
+    const SituationGraph &sg = sa.getModel();
+    size_t numOfOperations = operations.size();
+    size_t numOfCauses = 0;
+    causeLists.clear();
+    for (auto &operation : operations) {
+        causeLists.push_back(&sg.getImplicitCauses(sg.indexOf(operation.id)));
+        numOfCauses += causeLists.back()->size();
+    }
+    IoTEventBatch *batch = new IoTEventBatch(msg::IOT_EVENT_BATCH);
+    batch->setArrivalArraySize(numOfOperations);
+    batch->setEventIDArraySize(numOfOperations);
+    batch->setToTriggerArraySize(numOfOperations);
+    batch->setTimestampArraySize(numOfOperations);
+    batch->setCounterArraySize(numOfOperations);
+    batch->setTypeArraySize(numOfOperations);
+    batch->setCauseOffsetArraySize(numOfOperations);
+    batch->setCauseIndicesArraySize(numOfCauses);
+    batch->setCauseCountersArraySize(numOfCauses);
+    simtime_t current = simTime();
+    size_t c = 0;
+    for (size_t k = 0; k < numOfOperations; k++) {
+        const PhysicalOperation &operation = operations[arrivalOrder[k]];
+        batch->setArrival(k, current + latencies[arrivalOrder[k]]);
+        batch->setEventID(k, operation.id);
+        batch->setToTrigger(k, operation.toTrigger);
+        batch->setTimestamp(k, operation.timestamp);
+        batch->setCounter(k, operation.counter);
+        batch->setType(k, operation.type);
+        batch->setCauseOffset(k, c);
+        for (auto cause : *causeLists[arrivalOrder[k]]) {
+            batch->setCauseIndices(c, cause);
+            batch->setCauseCounters(c, sa.getInstanceAt(cause).counter);
+            c++;
+        }
+    }
+
+    /*
+     * 3. The batch travels with the smallest latency, the synchronizer holds the later
+     * operations back until their own arrival
+     */
+    sendDelayed(batch, latencies[arrivalOrder[0]], "out");
+}
@@ -19,13 +19,11 @@
 #include <omnetpp.h>
 #include <map>
 #include <vector>
-#include <nlohmann/json.hpp>
 #include "../objects/SituationArranger.h"
 #include "../transport/LatencyGenerator.h"
 
 using namespace std;
 using namespace omnetpp;
-using json = nlohmann::json;
 
 /**
  *
@@ -39,11 +37,22 @@ private:
     cMessage* EGTimeout;
     LatencyGenerator lg;
     SituationArranger sa;
+    // send the operations of a tick as one IoTEventBatch
+    bool batchEvents;
+    // latencies of the operations of a tick and their order of arrival
+    vector<simtime_t> latencies;
+    vector<size_t> arrivalOrder;
+    // implicit causes of the operations of a tick, as dense indices
+    vector<const vector<int>*> causeLists;
+
+    void sendEvent(const PhysicalOperation &operation);
+    void sendBatch(const vector<PhysicalOperation> &operations);
 
 protected:
     int toltalOperations;
     int toltalSituations;
-    virtual void initialize() override;
+    virtual int numInitStages() const override;
+    virtual void initialize(int stage) override;
     virtual void finish() override;
     virtual void handleMessage(cMessage *msg) override;
 
@@ -14,6 +14,7 @@
 // 
 
 #include "../common/Constants.h"
+#include "../common/Logger.h"
 #include "../messages/SimEvent_m.h"
 #include "Simulator.h"
 
@@ -31,9 +32,8 @@ void Simulator::handleMessage(cMessage *msg) {
     if (msg->isName(msg::SIM_EVENT)) {
         SimEvent *event = check_and_cast<SimEvent*>(msg);
 
-        cout << "Simulation event (" << event->getEventID() << "): timestamp "
-                << event->getTimestamp() << " count " << event->getCount()
-                << endl;
+        LOG_TRACE("Simulation event (" << event->getEventID() << "): timestamp "
+                << event->getTimestamp() << " count " << event->getCount());
 
         toltalOperations++;
 
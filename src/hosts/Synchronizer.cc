@@ -14,30 +14,26 @@
 // 
 
 #include "../common/Constants.h"
+#include "../common/Logger.h"
 #include "../common/Util.h"
 #include "../messages/IoTEvent_m.h"
+#include "../messages/IoTEventBatch_m.h"
 #include "../messages/SimEvent_m.h"
 #include "Synchronizer.h"
 
 Define_Module(Synchronizer);
 
 Synchronizer::Synchronizer() {
-    /*
-     * Construct a situation graph and a situation inference engine
-     */
-//    sr.initModel("../files/SG.json");
-    sr.initModel("../files/SG2.json");
-    sog.setModel(sr.getModel());
-    sog.setModelInstance(&sr);
-
     slice = 0;
-    // 500 ms
-    check_cycle = 0.5;
+    sumOfSqrDiffs = 0;
+    numOfBatches = 0;
     // 3000 ms
     slice_cycle = 3;
 
     SETimeout = new cMessage(msg::SE_TIMEOUT);
     SCTimeout = new cMessage(msg::SC_TIMEOUT);
+    // a situation expiring at the end of a slice is still reasoned about in that slice
+    SCTimeout->setSchedulingPriority(1);
 }
 
 Synchronizer::~Synchronizer() {
@@ -47,117 +43,260 @@ Synchronizer::~Synchronizer() {
     if (SCTimeout != NULL) {
         cancelAndDelete(SCTimeout);
     }
+    while (!pendingBatches.empty()) {
+        delete pendingBatches.top().batch;
+        pendingBatches.pop();
+    }
+}
+
+int Synchronizer::numInitStages() const {
+    return initStage::COUNT;
 }
 
-void Synchronizer::initialize() {
+void Synchronizer::initialize(int stage) {
+    if (stage == initStage::LOGGING) {
+        // logging is configured for the whole network
+        cModule *network = getSystemModule();
+        int logLevel = Logger::parseLevel(network->par("logLevel").stdstringValue());
+        if (logLevel < 0) {
+            throw cRuntimeError("Unknown log level: %s",
+                    network->par("logLevel").stdstringValue().c_str());
+        }
+        Logger::setLevel(logLevel);
+        Logger::setAsync(network->par("asyncLog").boolValue());
+        return;
+    }
+    if (stage != initStage::MODELS) {
+        return;
+    }
+
+    /*
+     * Construct a situation graph and a situation inference engine
+     */
+//    sr.initModel("../files/SG.json");
+    sr.initModel("../files/SG2.json");
+    sog.setModel(sr.getModelHandle());
+    sog.setModelInstance(&sr);
+    bufferCounters.assign(sr.getModel().numOfNodes(), 0);
+    actOBCounters.assign(sr.getModel().numOfNodes(), 0);
+    sqrDiffs.assign(sr.getModel().numOfNodes(), 0);
+
+    std::string backend = par("inferenceBackend").stdstringValue();
+    if (backend == "junctionTree") {
+        sr.setInferenceBackend(BNInferenceEngine::JUNCTION_TREE);
+    } else if (backend == "arithmeticCircuit") {
+        sr.setInferenceBackend(BNInferenceEngine::ARITHMETIC_CIRCUIT);
+    } else if (backend == "sampling") {
+        sr.setInferenceBudget(par("samplingBudget").intValue(),
+                par("samplingTimeBudget").doubleValue());
+        sr.setInferenceRNG(getRNG(0));
+        sr.setInferenceBackend(BNInferenceEngine::LIKELIHOOD_WEIGHTING);
+    } else if (backend != "dlib") {
+        throw cRuntimeError("Unknown inference backend: %s", backend.c_str());
+    }
+    sr.setInferenceCacheCapacity(par("inferenceCacheSize").intValue());
+    inferenceError.setName("Inference Error Estimate");
+    alignment.setHorizon(par("fidelityHorizon").doubleValue());
+    occurrenceFidelity.setName("Situation Occurrence Fidelity");
+    alignmentFidelity.setName("Situation Alignment Fidelity");
+
     // schedule situation evolution
-    scheduleAt(check_cycle, SCTimeout);
     scheduleAt(slice_cycle, SETimeout);
+    scheduleCheck();
 }
 
-void Synchronizer::finish() {
-    int consistency = sr.numOfConsistentOperation();
-    recordScalar("Recognized Consistent Operations", consistency);
+void Synchronizer::scheduleCheck() {
+    cancelEvent(SCTimeout);
+    simtime_t expiry = sr.nextExpiry();
+    if (expiry >= 0) {
+        scheduleAt(expiry, SCTimeout);
+    }
+}
+
+void Synchronizer::ingestEvent(long id, bool toTrigger, simtime_t timestamp,
+        int counter, short type, const AlignmentFidelity::cause_counts &causes) {
+    if (LOG_ENABLED(LOG_LEVEL_TRACE)) {
+        Logger::Record record;
+        record.stream() << "IoT event (" << id << "): toTrigger " << toTrigger
+                << ", counter " << counter << ", type " << type << ", cause counts [";
+        for (size_t k = 0; k < causes.size(); k++) {
+            record.stream() << (k ? "," : "") << "[" << causes[k].first << ","
+                    << causes[k].second << "]";
+        }
+        record.stream() << "], timestamp " << timestamp;
+    }
+
+    const SituationGraph &sg = sr.getModel();
+    int index = sg.indexOf(id);
+    if (index < 0) {
+        throw cRuntimeError("IoT event (%ld) of an unknown situation", id);
+    }
 
     /*
-     * Calculate situation occurrence fidelity
-     * TODO: currently, simulated and actual observable situations are not fully aligned here
+     * By rights, all received IoT events needs to be cached for regression if needed.
+     * Here, temporarily only triggering events are maintained for simplicity.
      */
-    std::vector<long> operations = sr.getModel().getAllOperationalSitutions();
-    double sum_sqr_diff = 0;
-    for(auto op : operations){
-        double so_count = (double)sr.getInstance(op).counter;
-        double ao_count = 0;
-        if(actOBCounters.count(op) > 0){
-            ao_count = (double)actOBCounters[op];
-            if(actOBCounters[op] > slice){
-                ao_count = slice;
-            }
+    if (toTrigger && type == SituationInstance::NORMAL) {
+        sog.cacheEvent(id, toTrigger, timestamp);
+
+        if (bufferCounters[index]++ == 0) {
+            bufferedSituations.push_back(index);
         }
-        sum_sqr_diff += pow((so_count - ao_count), 2);
-//        cout << "actual situation " << op << " count = " << ao_count << endl;
-//        cout << "simulated situation " << op << " count = " << so_count << endl;
     }
-    double fidelity_occ = 1- sqrt(sum_sqr_diff / (double)operations.size());
-    recordScalar("Situation Occurrence Fidelity", fidelity_occ);
-
-    cout << endl;
 
     /*
-     * Calculate situation alignment fidelity
+     * Update actual observable situation counter and cause counters for occurrence fidelity analysis
      */
-    double sum_sqr_max_diff = 0;
-    for(auto simCauseCounts : m_simCauseCounts){
-        long id = simCauseCounts.first.first;
-        long count = simCauseCounts.first.second;
-//        cout << "alignment fidelity calculation on "
-//                << simCauseCounts.first.first << ", "
-//                << simCauseCounts.first.second << endl;
-        si_id iid(id, count);
-        std::vector<int> countDiff;
-        for(auto causeCount : simCauseCounts.second){
-            long cause = causeCount.first;
-            int simCount = causeCount.second;
-            int actCount = m_actCauseCounts[iid][cause];
-            countDiff.push_back(abs(simCount - actCount));
-//            cout << "cause " << causeCount.first << " simulated count: " << simCount << endl;
-//            cout << "cause " << causeCount.first << " actual count: " << actCount << endl;
+    if (toTrigger){
+        if (++actOBCounters[index] == slice + 1) {
+            capped.push_back(index);
         }
-        if(countDiff.size() > 0){
-            int max_diff = *std::max_element(countDiff.begin(), countDiff.end());
-            sum_sqr_max_diff += pow(max_diff, 2);
-//            cout << "max situation (" << id << ", " << count << ") max misalignment = " << max_diff << endl;
-        }else{
-//            cout << "no cause of situation (" << id << ", " << count << ")" << endl;
+        updateOccurrence(index);
+        for (auto &cause : causes) {
+            if (cause.first < 0 || cause.first >= (int) sg.nodes.size()) {
+                throw cRuntimeError("IoT event (%ld) carries an unknown cause index %d",
+                        id, cause.first);
+            }
         }
+        int count = actOBCounters[index];
+        si_id actOBId(id, count);
+        alignment.recordActual(actOBId, causes, simTime());
     }
-    double fidelity_ali = sqrt(sum_sqr_max_diff / (double)m_simCauseCounts.size());
-    recordScalar("Situation Alignment Fidelity", fidelity_ali);
 }
 
-void Synchronizer::handleMessage(cMessage *msg) {
-    if (msg->isName(msg::IOT_EVENT)) {
-        IoTEvent *event = check_and_cast<IoTEvent*>(msg);
-
-        cout << "IoT event (" << event->getEventID() << "): toTrigger "
-                << event->getToTrigger() << ", counter " << event->getCounter()
-                << ", type " << event->getType() << ", cause counts "
-                << event->getCauseCounts() << ", timestamp "
-                << event->getTimestamp() << endl;
+void Synchronizer::ingestPending(simtime_t until, bool inclusive) {
+    while (!pendingBatches.empty()) {
+        PendingBatch pending = pendingBatches.top();
+        if (pending.arrival > until || (!inclusive && pending.arrival == until)) {
+            break;
+        }
+        pendingBatches.pop();
 
         /*
-         * By rights, all received IoT events needs to be cached for regression if needed.
-         * Here, temporarily only triggering events are maintained for simplicity.
+         * Ingest the due operations of the batch in one pass, as long as they arrive
+         * before the next operation of any other pending batch
          */
-        if (event->getToTrigger() && event->getType() == SituationInstance::NORMAL) {
-            sog.cacheEvent(event->getEventID(), event->getToTrigger(),
-                    event->getTimestamp());
-
-            long id = event->getEventID();
-            if (bufferCounters.count(id)) {
-                bufferCounters[id]++;
-            } else {
-                bufferCounters[id] = 1;
+        IoTEventBatch *batch = pending.batch;
+        size_t numOfOperations = batch->getEventIDArraySize();
+        size_t numOfCauses = batch->getCauseIndicesArraySize();
+        while (true) {
+            size_t k = pending.next++;
+            size_t end = pending.next < numOfOperations ?
+                    batch->getCauseOffset(pending.next) : numOfCauses;
+            eventCauses.clear();
+            for (size_t c = batch->getCauseOffset(k); c < end; c++) {
+                eventCauses.push_back(std::make_pair(batch->getCauseIndices(c),
+                        batch->getCauseCounters(c)));
+            }
+            ingestEvent(batch->getEventID(k), batch->getToTrigger(k),
+                    batch->getTimestamp(k), batch->getCounter(k), batch->getType(k),
+                    eventCauses);
+
+            if (pending.next == numOfOperations) {
+                break;
+            }
+            pending.arrival = batch->getArrival(pending.next);
+            if (pending.arrival > until || (!inclusive && pending.arrival == until)
+                    || (!pendingBatches.empty() && pending > pendingBatches.top())) {
+                break;
             }
         }
 
-        /*
-         * Update actual observable situation counter and cause counters for occurrence fidelity analysis
-         */
-        if (event->getToTrigger()){
-            long id = event->getEventID();
-            actOBCounters.count(id) > 0 ? actOBCounters[id]++ : (actOBCounters[id] = 1);
-            json j_causeCounts = json::parse(string(event->getCauseCounts()));
-            std::map<long, int> causeCounts = j_causeCounts.get<std::map<long, int>>();
-//            std::vector<si_id> actOBCauseCounts;
-//            std::copy(causeCounts.begin(), causeCounts.end(), std::back_inserter(actOBCauseCounts));
-            int count = actOBCounters[id];
-            si_id actOBId(id, count);
-            m_actCauseCounts[actOBId] = causeCounts;
+        if (pending.next < numOfOperations) {
+            pendingBatches.push(pending);
+        } else {
+            // free up memory space
+            delete batch;
+        }
+    }
+}
+
+void Synchronizer::finish() {
+    // operations that have arrived by the end of the simulation
+    ingestPending(simTime(), true);
+
+    int consistency = sr.numOfConsistentOperation();
+    recordScalar("Recognized Consistent Operations", consistency);
+    recordScalar("Inference Cache Hits", sr.numOfInferenceCacheHits());
+    recordScalar("Inference Cache Misses", sr.numOfInferenceCacheMisses());
+
+    recordScalar("Situation Occurrence Fidelity", getOccurrenceFidelity());
+
+    /*
+     * Calculate situation alignment fidelity, including the simulated situations whose
+     * actual counterpart has not been observed
+     */
+    alignment.settle();
+    recordScalar("Situation Alignment Fidelity", alignment.getFidelity());
+
+    Logger::flush();
+}
+
+void Synchronizer::updateOccurrence(int index) {
+    const SituationGraph &sg = sr.getModel();
+    if (sg.nodes[index].layer != sg.modelHeight() - 1) {
+        return;
+    }
+    long so_count = sr.getInstanceAt(index).counter;
+    int actOBCounter = actOBCounters[index];
+    long ao_count = actOBCounter > slice ? slice : actOBCounter;
+    sumOfSqrDiffs -= sqrDiffs[index];
+    sqrDiffs[index] = (so_count - ao_count) * (so_count - ao_count);
+    sumOfSqrDiffs += sqrDiffs[index];
+}
+
+void Synchronizer::updateSlice(int current) {
+    /*
+     * Only the actual counters above the previous slice see their cap raised
+     */
+    slice = current;
+    size_t numOfCapped = 0;
+    for (auto index : capped) {
+        updateOccurrence(index);
+        if (actOBCounters[index] > slice) {
+            capped[numOfCapped++] = index;
         }
+    }
+    capped.resize(numOfCapped);
+}
+
+double Synchronizer::getOccurrenceFidelity() {
+    /*
+     * Calculate situation occurrence fidelity
+     * TODO: currently, simulated and actual observable situations are not fully aligned here
+     */
+    size_t numOfOperations = sr.getModel().getAllOperationalSitutions().size();
+    return 1- sqrt(sumOfSqrDiffs / (double)numOfOperations);
+}
+
+void Synchronizer::handleMessage(cMessage *msg) {
+    if (msg->isName(msg::IOT_EVENT)) {
+        IoTEvent *event = check_and_cast<IoTEvent*>(msg);
+        eventCauses.clear();
+        for (size_t k = 0; k < event->getCauseIndicesArraySize(); k++) {
+            eventCauses.push_back(std::make_pair(event->getCauseIndices(k),
+                    event->getCauseCounters(k)));
+        }
+        ingestEvent(event->getEventID(), event->getToTrigger(),
+                event->getTimestamp(), event->getCounter(), event->getType(),
+                eventCauses);
 
         // free up memory space
         delete event;
+    } else if (msg->isName(msg::IOT_EVENT_BATCH)) {
+        /*
+         * The batch arrives with its first operation, the later ones are held back until
+         * their own arrival
+         */
+        IoTEventBatch *batch = check_and_cast<IoTEventBatch*>(msg);
+        if (batch->getEventIDArraySize() == 0) {
+            delete batch;
+        } else {
+            PendingBatch pending = { batch->getArrival(0), batch->getSendingTime(),
+                    numOfBatches++, batch, 0 };
+            pendingBatches.push(pending);
+        }
+        ingestPending(simTime(), true);
     } else if (msg->isName(msg::SE_TIMEOUT)) {
 
         /*
@@ -165,40 +304,57 @@ void Synchronizer::handleMessage(cMessage *msg) {
          */
 
         simtime_t current = simTime();
-        slice = (int) (current / slice_cycle);
-        cout << endl << "current time slice: " << current << "(" << slice << ")"
-                << endl;
-
-        std::set<long> triggered;
+        /*
+         * An operation arriving right now would have been queued behind this timeout
+         */
+        ingestPending(current, false);
+        updateSlice((int) (current / slice_cycle));
+        LOG_INFO("\ncurrent time slice: " << current << "(" << slice << ")");
 
 //        cout << "print buffer counters: ";
-//        util::printMap(bufferCounters);
+//        util::printVector(bufferCounters);
 
         /*
          * 1. Get triggered observable situations
+         * Only the buffered situations are visited, and those still buffered after this
+         * slice are kept. triggered is ordered by itself; the list is sorted by ID only so
+         * that the debug log lists the buffered situations in the order of the map of
+         * buffer counters it replaced. It holds the few situations buffered since the
+         * last slices, so the sort is cheap.
          */
-        for (auto bufferCounter : bufferCounters) {
-            if (bufferCounter.second > 0) {
+        const SituationGraph &sg = sr.getModel();
+        std::sort(bufferedSituations.begin(), bufferedSituations.end(),
+                [&sg](int a, int b) { return sg.nodes[a].id < sg.nodes[b].id; });
+        size_t numOfBuffered = 0;
+        triggered.clear();
+        for (auto index : bufferedSituations) {
+            long id = sg.nodes[index].id;
 
-                cout << "triggered ID " << bufferCounter.first << ", counter " << bufferCounter.second << endl;
+            LOG_DEBUG("triggered ID " << id << ", counter " << bufferCounters[index]);
 
-                triggered.insert(bufferCounter.first);
-                bufferCounters[bufferCounter.first]--;
+            triggered.push_back(index);
+            if (--bufferCounters[index] > 0) {
+                bufferedSituations[numOfBuffered++] = index;
             }
         }
+        bufferedSituations.resize(numOfBuffered);
 
         /*
          * 2. Situation inference
          * The inference result contains a list of triggered observable situations,
          * which is supposed to tell SOG to generate the corresponding simulation events.
          */
-        std::set<long> tOperations = sr.reason(triggered, current);
+        sr.reason(triggered, current, tOperations);
+        inferenceError.record(sr.getInferenceError());
+        for (auto index : sr.getFiredOperations()) {
+            updateOccurrence(index);
+        }
 
         /*
          * Update simulated observable situation counter and cause counters for alignment fidelity analysis
          */
         for(auto op : tOperations){
-            std::map<long, int> causeCounts;
+            simCauses.clear();
             /*
              * Check the explicit cause only
              */
@@ -209,17 +365,23 @@ void Synchronizer::handleMessage(cMessage *msg) {
             /*
              * Check both explicit cause and implicit cause
              */
-            std::vector<long> operations = sr.getModel().getAllOperationalSitutions();
-            for(auto op2 : operations){
-                if(op2 != op && sr.getModel().isReachable(op2, op) && !sr.getModel().isReachable(op, op2)){
-                    causeCounts[op2] = sr.getInstance(op2).counter;
-                }
+            int index = sg.indexOf(op);
+            for(auto op2 : sg.getImplicitCauses(index)){
+                simCauses.push_back(std::make_pair(op2, sr.getInstanceAt(op2).counter));
             }
-//            std::vector<si_id> simOBCauseCounts;
-//            std::copy(causeCounts.begin(), causeCounts.end(), std::back_inserter(simOBCauseCounts));
-            int count = sr.getInstance(op).counter;
+            int count = sr.getInstanceAt(index).counter;
             si_id simOBId(op, count);
-            m_simCauseCounts[simOBId] = causeCounts;
+            alignment.recordSimulated(simOBId, simCauses, current);
+        }
+
+        /*
+         * Emit the fidelity up to this cycle, settling the situation instances that have
+         * been unmatched for too long
+         */
+        alignment.evict(current);
+        occurrenceFidelity.record(getOccurrenceFidelity());
+        if (alignment.numOfCompared() > 0) {
+            alignmentFidelity.record(alignment.getFidelity());
         }
 
         /*
@@ -227,8 +389,11 @@ void Synchronizer::handleMessage(cMessage *msg) {
          */
         std::queue<std::vector<VirtualOperation>> opSets = sog.generateOperations(
                 tOperations);
-        cout << "Operation sets are: " << endl;
-        util::printComplexQueue(opSets);
+        if (LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+            Logger::Record record;
+            record.stream() << "Operation sets are: " << endl;
+            util::printComplexQueue(opSets, record.stream());
+        }
 
         /*
          * 4. Send operations to simulator
@@ -249,8 +414,11 @@ void Synchronizer::handleMessage(cMessage *msg) {
         }
 
         scheduleAt(simTime() + slice_cycle, SETimeout);
+        scheduleCheck();
     } else if (msg->isName(msg::SC_TIMEOUT)) {
+        // the check has a lower priority than the operations arriving right now
+        ingestPending(simTime(), true);
         sr.checkState(simTime());
-        scheduleAt(simTime() + check_cycle, SCTimeout);
+        scheduleCheck();
     }
 }
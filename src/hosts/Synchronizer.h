@@ -19,8 +19,8 @@
 #include <bits/stdc++.h>
 #include <cmath>
 #include <omnetpp.h>
-#include <nlohmann/json.hpp>
 
+#include "../objects/AlignmentFidelity.h"
 #include "../objects/OperationGenerator.h"
 #include "../objects/SituationReasoner.h"
 #include "../transport/LatencyGenerator.h"
@@ -28,7 +28,8 @@
 
 using namespace omnetpp;
 using namespace std;
-using json = nlohmann::json;
+
+class IoTEventBatch;
 
 /**
  * TODO - Generated class
@@ -36,33 +37,81 @@ using json = nlohmann::json;
 class Synchronizer: public cSimpleModule {
 private:
     int slice;
-    // cycle to check durable situations
-    simtime_t check_cycle;
     // time slice
     simtime_t slice_cycle;
     // situation evolution timeout
     cMessage* SETimeout;
-    // situation check timeout
+    // situation check timeout, scheduled at the next expiry of a triggering situation
     cMessage* SCTimeout;
+    // error estimate of every situation inference
+    cOutVector inferenceError;
 
     SituationReasoner sr;
     OperationGenerator sog;
     LatencyGenerator lg;
-    // <situation_ID, trigger_counter>, a buffer to cache observable situation triggering for implementing situation evolution scheduling
-    std::map<long, int> bufferCounters;
-    // <situation_ID, trigger_coutner> for actual observable situations
-    std::map<long, int> actOBCounters;
-    // <observable_situation_ID, trigger_coutner> for simulated observable situations
-    std::map<long, int> simOBCounters;
+    // trigger counters by situation index, a buffer to cache observable situation triggering for implementing situation evolution scheduling
+    std::vector<int> bufferCounters;
+    // indices of the situations with a non-zero buffer counter
+    std::vector<int> bufferedSituations;
+    // trigger counters by situation index for actual observable situations
+    std::vector<int> actOBCounters;
+    /*
+     * Squared difference between the simulated and actual counters of every operational
+     * situation and their sum, updated as the counters change. The actual counter is
+     * capped at the slice, so the situations above the cap are updated as it grows.
+     */
+    std::vector<long> sqrDiffs;
+    long sumOfSqrDiffs;
+    std::vector<int> capped;
     // situation instance ID: <situation_id, counter>
-    typedef std::pair<long, int> si_id;
-    // cause counters of actual situations: <si_id, list_of_cause_counter>
-    std::map<si_id, std::map<long, int>> m_actCauseCounts;
-    // cause counters of simulated situations: <si_id, list_of_cause_counter>
-    std::map<si_id, std::map<long, int>> m_simCauseCounts;
+    typedef AlignmentFidelity::si_id si_id;
+    // cause counters of the actual and simulated situation instances not compared yet
+    AlignmentFidelity alignment;
+    // fidelity of every situation evolution cycle
+    cOutVector occurrenceFidelity;
+    cOutVector alignmentFidelity;
+
+    // a received IoT event batch, waiting for the arrival of its next operation
+    struct PendingBatch {
+        simtime_t arrival;
+        simtime_t sent;
+        long seq;
+        IoTEventBatch *batch;
+        size_t next;
+        // operations arriving together are ingested in the order they were sent
+        bool operator>(const PendingBatch &other) const {
+            if (arrival != other.arrival) {
+                return arrival > other.arrival;
+            }
+            if (sent != other.sent) {
+                return sent > other.sent;
+            }
+            return seq > other.seq;
+        }
+    };
+    std::priority_queue<PendingBatch, std::vector<PendingBatch>,
+            std::greater<PendingBatch>> pendingBatches;
+    long numOfBatches;
+    // <cause index, cause counter> pairs unpacked from an IoT event, and those of a
+    // simulated operational situation, reused by every event and slice
+    AlignmentFidelity::cause_counts eventCauses;
+    AlignmentFidelity::cause_counts simCauses;
+    // dense indices of the buffered situations triggered in the current slice, by ID
+    std::vector<int> triggered;
+    // operational situations triggered in the current slice
+    std::vector<long> tOperations;
+
+    void scheduleCheck();
+    void updateOccurrence(int index);
+    void updateSlice(int current);
+    double getOccurrenceFidelity();
+    void ingestEvent(long id, bool toTrigger, simtime_t timestamp, int counter,
+            short type, const AlignmentFidelity::cause_counts &causes);
+    void ingestPending(simtime_t until, bool inclusive);
 
 protected:
-    virtual void initialize() override;
+    virtual int numInitStages() const override;
+    virtual void initialize(int stage) override;
     virtual void finish() override;
     virtual void handleMessage(cMessage *msg) override;
 
@@ -0,0 +1,1332 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.0 from messages/IoTEventBatch.msg.
+//
+
+// Disable warnings about unused variables, empty switch stmts, etc:
+#ifdef _MSC_VER
+#  pragma warning(disable:4101)
+#  pragma warning(disable:4065)
+#endif
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wshadow"
+#  pragma clang diagnostic ignored "-Wconversion"
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+#  pragma clang diagnostic ignored "-Wc++98-compat"
+#  pragma clang diagnostic ignored "-Wunreachable-code-break"
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#elif defined(__GNUC__)
+#  pragma GCC diagnostic ignored "-Wshadow"
+#  pragma GCC diagnostic ignored "-Wconversion"
+#  pragma GCC diagnostic ignored "-Wunused-parameter"
+#  pragma GCC diagnostic ignored "-Wold-style-cast"
+#  pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
+#  pragma GCC diagnostic ignored "-Wfloat-conversion"
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <type_traits>
+#include "IoTEventBatch_m.h"
+
+namespace omnetpp {
+
+// Template pack/unpack rules. They are declared *after* a1l type-specific pack functions for multiple reasons.
+// They are in the omnetpp namespace, to allow them to be found by argument-dependent lookup via the cCommBuffer argument
+
+// Packing/unpacking an std::vector
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::vector<T,A>& v)
+{
+    int n = v.size();
+    doParsimPacking(buffer, n);
+    for (int i = 0; i < n; i++)
+        doParsimPacking(buffer, v[i]);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::vector<T,A>& v)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    v.resize(n);
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(buffer, v[i]);
+}
+
+// Packing/unpacking an std::list
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::list<T,A>& l)
+{
+    doParsimPacking(buffer, (int)l.size());
+    for (typename std::list<T,A>::const_iterator it = l.begin(); it != l.end(); ++it)
+        doParsimPacking(buffer, (T&)*it);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::list<T,A>& l)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        l.push_back(T());
+        doParsimUnpacking(buffer, l.back());
+    }
+}
+
+// Packing/unpacking an std::set
+template<typename T, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::set<T,Tr,A>& s)
+{
+    doParsimPacking(buffer, (int)s.size());
+    for (typename std::set<T,Tr,A>::const_iterator it = s.begin(); it != s.end(); ++it)
+        doParsimPacking(buffer, *it);
+}
+
+template<typename T, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::set<T,Tr,A>& s)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        T x;
+        doParsimUnpacking(buffer, x);
+        s.insert(x);
+    }
+}
+
+// Packing/unpacking an std::map
+template<typename K, typename V, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::map<K,V,Tr,A>& m)
+{
+    doParsimPacking(buffer, (int)m.size());
+    for (typename std::map<K,V,Tr,A>::const_iterator it = m.begin(); it != m.end(); ++it) {
+        doParsimPacking(buffer, it->first);
+        doParsimPacking(buffer, it->second);
+    }
+}
+
+template<typename K, typename V, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::map<K,V,Tr,A>& m)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        K k; V v;
+        doParsimUnpacking(buffer, k);
+        doParsimUnpacking(buffer, v);
+        m[k] = v;
+    }
+}
+
+// Default pack/unpack function for arrays
+template<typename T>
+void doParsimArrayPacking(omnetpp::cCommBuffer *b, const T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimPacking(b, t[i]);
+}
+
+template<typename T>
+void doParsimArrayUnpacking(omnetpp::cCommBuffer *b, T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(b, t[i]);
+}
+
+// Default rule to prevent compiler from choosing base class' doParsimPacking() function
+template<typename T>
+void doParsimPacking(omnetpp::cCommBuffer *, const T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimPacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+template<typename T>
+void doParsimUnpacking(omnetpp::cCommBuffer *, T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimUnpacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+}  // namespace omnetpp
+
+Register_Class(IoTEventBatch)
+
+IoTEventBatch::IoTEventBatch(const char *name, short kind) : ::omnetpp::cPacket(name, kind)
+{
+}
+
+IoTEventBatch::IoTEventBatch(const IoTEventBatch& other) : ::omnetpp::cPacket(other)
+{
+    copy(other);
+}
+
+IoTEventBatch::~IoTEventBatch()
+{
+    delete [] this->arrival;
+    delete [] this->eventID;
+    delete [] this->toTrigger;
+    delete [] this->timestamp;
+    delete [] this->counter;
+    delete [] this->type;
+    delete [] this->causeOffset;
+    delete [] this->causeIndices;
+    delete [] this->causeCounters;
+}
+
+IoTEventBatch& IoTEventBatch::operator=(const IoTEventBatch& other)
+{
+    if (this == &other) return *this;
+    ::omnetpp::cPacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void IoTEventBatch::copy(const IoTEventBatch& other)
+{
+    delete [] this->arrival;
+    this->arrival = (other.arrival_arraysize==0) ? nullptr : new omnetpp::simtime_t[other.arrival_arraysize];
+    arrival_arraysize = other.arrival_arraysize;
+    for (size_t i = 0; i < arrival_arraysize; i++) {
+        this->arrival[i] = other.arrival[i];
+    }
+    delete [] this->eventID;
+    this->eventID = (other.eventID_arraysize==0) ? nullptr : new long[other.eventID_arraysize];
+    eventID_arraysize = other.eventID_arraysize;
+    for (size_t i = 0; i < eventID_arraysize; i++) {
+        this->eventID[i] = other.eventID[i];
+    }
+    delete [] this->toTrigger;
+    this->toTrigger = (other.toTrigger_arraysize==0) ? nullptr : new bool[other.toTrigger_arraysize];
+    toTrigger_arraysize = other.toTrigger_arraysize;
+    for (size_t i = 0; i < toTrigger_arraysize; i++) {
+        this->toTrigger[i] = other.toTrigger[i];
+    }
+    delete [] this->timestamp;
+    this->timestamp = (other.timestamp_arraysize==0) ? nullptr : new omnetpp::simtime_t[other.timestamp_arraysize];
+    timestamp_arraysize = other.timestamp_arraysize;
+    for (size_t i = 0; i < timestamp_arraysize; i++) {
+        this->timestamp[i] = other.timestamp[i];
+    }
+    delete [] this->counter;
+    this->counter = (other.counter_arraysize==0) ? nullptr : new int[other.counter_arraysize];
+    counter_arraysize = other.counter_arraysize;
+    for (size_t i = 0; i < counter_arraysize; i++) {
+        this->counter[i] = other.counter[i];
+    }
+    delete [] this->type;
+    this->type = (other.type_arraysize==0) ? nullptr : new short[other.type_arraysize];
+    type_arraysize = other.type_arraysize;
+    for (size_t i = 0; i < type_arraysize; i++) {
+        this->type[i] = other.type[i];
+    }
+    delete [] this->causeOffset;
+    this->causeOffset = (other.causeOffset_arraysize==0) ? nullptr : new int[other.causeOffset_arraysize];
+    causeOffset_arraysize = other.causeOffset_arraysize;
+    for (size_t i = 0; i < causeOffset_arraysize; i++) {
+        this->causeOffset[i] = other.causeOffset[i];
+    }
+    delete [] this->causeIndices;
+    this->causeIndices = (other.causeIndices_arraysize==0) ? nullptr : new int[other.causeIndices_arraysize];
+    causeIndices_arraysize = other.causeIndices_arraysize;
+    for (size_t i = 0; i < causeIndices_arraysize; i++) {
+        this->causeIndices[i] = other.causeIndices[i];
+    }
+    delete [] this->causeCounters;
+    this->causeCounters = (other.causeCounters_arraysize==0) ? nullptr : new int[other.causeCounters_arraysize];
+    causeCounters_arraysize = other.causeCounters_arraysize;
+    for (size_t i = 0; i < causeCounters_arraysize; i++) {
+        this->causeCounters[i] = other.causeCounters[i];
+    }
+}
+
+void IoTEventBatch::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cPacket::parsimPack(b);
+    b->pack(arrival_arraysize);
+    doParsimArrayPacking(b,this->arrival,arrival_arraysize);
+    b->pack(eventID_arraysize);
+    doParsimArrayPacking(b,this->eventID,eventID_arraysize);
+    b->pack(toTrigger_arraysize);
+    doParsimArrayPacking(b,this->toTrigger,toTrigger_arraysize);
+    b->pack(timestamp_arraysize);
+    doParsimArrayPacking(b,this->timestamp,timestamp_arraysize);
+    b->pack(counter_arraysize);
+    doParsimArrayPacking(b,this->counter,counter_arraysize);
+    b->pack(type_arraysize);
+    doParsimArrayPacking(b,this->type,type_arraysize);
+    b->pack(causeOffset_arraysize);
+    doParsimArrayPacking(b,this->causeOffset,causeOffset_arraysize);
+    b->pack(causeIndices_arraysize);
+    doParsimArrayPacking(b,this->causeIndices,causeIndices_arraysize);
+    b->pack(causeCounters_arraysize);
+    doParsimArrayPacking(b,this->causeCounters,causeCounters_arraysize);
+}
+
+void IoTEventBatch::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cPacket::parsimUnpack(b);
+    delete [] this->arrival;
+    b->unpack(arrival_arraysize);
+    if (arrival_arraysize == 0) {
+        this->arrival = nullptr;
+    } else {
+        this->arrival = new omnetpp::simtime_t[arrival_arraysize];
+        doParsimArrayUnpacking(b,this->arrival,arrival_arraysize);
+    }
+    delete [] this->eventID;
+    b->unpack(eventID_arraysize);
+    if (eventID_arraysize == 0) {
+        this->eventID = nullptr;
+    } else {
+        this->eventID = new long[eventID_arraysize];
+        doParsimArrayUnpacking(b,this->eventID,eventID_arraysize);
+    }
+    delete [] this->toTrigger;
+    b->unpack(toTrigger_arraysize);
+    if (toTrigger_arraysize == 0) {
+        this->toTrigger = nullptr;
+    } else {
+        this->toTrigger = new bool[toTrigger_arraysize];
+        doParsimArrayUnpacking(b,this->toTrigger,toTrigger_arraysize);
+    }
+    delete [] this->timestamp;
+    b->unpack(timestamp_arraysize);
+    if (timestamp_arraysize == 0) {
+        this->timestamp = nullptr;
+    } else {
+        this->timestamp = new omnetpp::simtime_t[timestamp_arraysize];
+        doParsimArrayUnpacking(b,this->timestamp,timestamp_arraysize);
+    }
+    delete [] this->counter;
+    b->unpack(counter_arraysize);
+    if (counter_arraysize == 0) {
+        this->counter = nullptr;
+    } else {
+        this->counter = new int[counter_arraysize];
+        doParsimArrayUnpacking(b,this->counter,counter_arraysize);
+    }
+    delete [] this->type;
+    b->unpack(type_arraysize);
+    if (type_arraysize == 0) {
+        this->type = nullptr;
+    } else {
+        this->type = new short[type_arraysize];
+        doParsimArrayUnpacking(b,this->type,type_arraysize);
+    }
+    delete [] this->causeOffset;
+    b->unpack(causeOffset_arraysize);
+    if (causeOffset_arraysize == 0) {
+        this->causeOffset = nullptr;
+    } else {
+        this->causeOffset = new int[causeOffset_arraysize];
+        doParsimArrayUnpacking(b,this->causeOffset,causeOffset_arraysize);
+    }
+    delete [] this->causeIndices;
+    b->unpack(causeIndices_arraysize);
+    if (causeIndices_arraysize == 0) {
+        this->causeIndices = nullptr;
+    } else {
+        this->causeIndices = new int[causeIndices_arraysize];
+        doParsimArrayUnpacking(b,this->causeIndices,causeIndices_arraysize);
+    }
+    delete [] this->causeCounters;
+    b->unpack(causeCounters_arraysize);
+    if (causeCounters_arraysize == 0) {
+        this->causeCounters = nullptr;
+    } else {
+        this->causeCounters = new int[causeCounters_arraysize];
+        doParsimArrayUnpacking(b,this->causeCounters,causeCounters_arraysize);
+    }
+}
+
+size_t IoTEventBatch::getArrivalArraySize() const
+{
+    return arrival_arraysize;
+}
+
+omnetpp::simtime_t IoTEventBatch::getArrival(size_t k) const
+{
+    if (k >= arrival_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)arrival_arraysize, (unsigned long)k);
+    return this->arrival[k];
+}
+
+void IoTEventBatch::setArrivalArraySize(size_t newSize)
+{
+    omnetpp::simtime_t *arrival2 = (newSize==0) ? nullptr : new omnetpp::simtime_t[newSize];
+    size_t minSize = arrival_arraysize < newSize ? arrival_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        arrival2[i] = this->arrival[i];
+    for (size_t i = minSize; i < newSize; i++)
+        arrival2[i] = SIMTIME_ZERO;
+    delete [] this->arrival;
+    this->arrival = arrival2;
+    arrival_arraysize = newSize;
+}
+
+void IoTEventBatch::setArrival(size_t k, omnetpp::simtime_t arrival)
+{
+    if (k >= arrival_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)arrival_arraysize, (unsigned long)k);
+    this->arrival[k] = arrival;
+}
+
+void IoTEventBatch::insertArrival(size_t k, omnetpp::simtime_t arrival)
+{
+    if (k > arrival_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)arrival_arraysize, (unsigned long)k);
+    size_t newSize = arrival_arraysize + 1;
+    omnetpp::simtime_t *arrival2 = new omnetpp::simtime_t[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        arrival2[i] = this->arrival[i];
+    arrival2[k] = arrival;
+    for (i = k + 1; i < newSize; i++)
+        arrival2[i] = this->arrival[i-1];
+    delete [] this->arrival;
+    this->arrival = arrival2;
+    arrival_arraysize = newSize;
+}
+
+void IoTEventBatch::appendArrival(omnetpp::simtime_t arrival)
+{
+    insertArrival(arrival_arraysize, arrival);
+}
+
+void IoTEventBatch::eraseArrival(size_t k)
+{
+    if (k >= arrival_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)arrival_arraysize, (unsigned long)k);
+    size_t newSize = arrival_arraysize - 1;
+    omnetpp::simtime_t *arrival2 = (newSize == 0) ? nullptr : new omnetpp::simtime_t[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        arrival2[i] = this->arrival[i];
+    for (i = k; i < newSize; i++)
+        arrival2[i] = this->arrival[i+1];
+    delete [] this->arrival;
+    this->arrival = arrival2;
+    arrival_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getEventIDArraySize() const
+{
+    return eventID_arraysize;
+}
+
+long IoTEventBatch::getEventID(size_t k) const
+{
+    if (k >= eventID_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)eventID_arraysize, (unsigned long)k);
+    return this->eventID[k];
+}
+
+void IoTEventBatch::setEventIDArraySize(size_t newSize)
+{
+    long *eventID2 = (newSize==0) ? nullptr : new long[newSize];
+    size_t minSize = eventID_arraysize < newSize ? eventID_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        eventID2[i] = this->eventID[i];
+    for (size_t i = minSize; i < newSize; i++)
+        eventID2[i] = 0;
+    delete [] this->eventID;
+    this->eventID = eventID2;
+    eventID_arraysize = newSize;
+}
+
+void IoTEventBatch::setEventID(size_t k, long eventID)
+{
+    if (k >= eventID_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)eventID_arraysize, (unsigned long)k);
+    this->eventID[k] = eventID;
+}
+
+void IoTEventBatch::insertEventID(size_t k, long eventID)
+{
+    if (k > eventID_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)eventID_arraysize, (unsigned long)k);
+    size_t newSize = eventID_arraysize + 1;
+    long *eventID2 = new long[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        eventID2[i] = this->eventID[i];
+    eventID2[k] = eventID;
+    for (i = k + 1; i < newSize; i++)
+        eventID2[i] = this->eventID[i-1];
+    delete [] this->eventID;
+    this->eventID = eventID2;
+    eventID_arraysize = newSize;
+}
+
+void IoTEventBatch::appendEventID(long eventID)
+{
+    insertEventID(eventID_arraysize, eventID);
+}
+
+void IoTEventBatch::eraseEventID(size_t k)
+{
+    if (k >= eventID_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)eventID_arraysize, (unsigned long)k);
+    size_t newSize = eventID_arraysize - 1;
+    long *eventID2 = (newSize == 0) ? nullptr : new long[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        eventID2[i] = this->eventID[i];
+    for (i = k; i < newSize; i++)
+        eventID2[i] = this->eventID[i+1];
+    delete [] this->eventID;
+    this->eventID = eventID2;
+    eventID_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getToTriggerArraySize() const
+{
+    return toTrigger_arraysize;
+}
+
+bool IoTEventBatch::getToTrigger(size_t k) const
+{
+    if (k >= toTrigger_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)toTrigger_arraysize, (unsigned long)k);
+    return this->toTrigger[k];
+}
+
+void IoTEventBatch::setToTriggerArraySize(size_t newSize)
+{
+    bool *toTrigger2 = (newSize==0) ? nullptr : new bool[newSize];
+    size_t minSize = toTrigger_arraysize < newSize ? toTrigger_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        toTrigger2[i] = this->toTrigger[i];
+    for (size_t i = minSize; i < newSize; i++)
+        toTrigger2[i] = false;
+    delete [] this->toTrigger;
+    this->toTrigger = toTrigger2;
+    toTrigger_arraysize = newSize;
+}
+
+void IoTEventBatch::setToTrigger(size_t k, bool toTrigger)
+{
+    if (k >= toTrigger_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)toTrigger_arraysize, (unsigned long)k);
+    this->toTrigger[k] = toTrigger;
+}
+
+void IoTEventBatch::insertToTrigger(size_t k, bool toTrigger)
+{
+    if (k > toTrigger_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)toTrigger_arraysize, (unsigned long)k);
+    size_t newSize = toTrigger_arraysize + 1;
+    bool *toTrigger2 = new bool[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        toTrigger2[i] = this->toTrigger[i];
+    toTrigger2[k] = toTrigger;
+    for (i = k + 1; i < newSize; i++)
+        toTrigger2[i] = this->toTrigger[i-1];
+    delete [] this->toTrigger;
+    this->toTrigger = toTrigger2;
+    toTrigger_arraysize = newSize;
+}
+
+void IoTEventBatch::appendToTrigger(bool toTrigger)
+{
+    insertToTrigger(toTrigger_arraysize, toTrigger);
+}
+
+void IoTEventBatch::eraseToTrigger(size_t k)
+{
+    if (k >= toTrigger_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)toTrigger_arraysize, (unsigned long)k);
+    size_t newSize = toTrigger_arraysize - 1;
+    bool *toTrigger2 = (newSize == 0) ? nullptr : new bool[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        toTrigger2[i] = this->toTrigger[i];
+    for (i = k; i < newSize; i++)
+        toTrigger2[i] = this->toTrigger[i+1];
+    delete [] this->toTrigger;
+    this->toTrigger = toTrigger2;
+    toTrigger_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getTimestampArraySize() const
+{
+    return timestamp_arraysize;
+}
+
+omnetpp::simtime_t IoTEventBatch::getTimestamp(size_t k) const
+{
+    if (k >= timestamp_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)timestamp_arraysize, (unsigned long)k);
+    return this->timestamp[k];
+}
+
+void IoTEventBatch::setTimestampArraySize(size_t newSize)
+{
+    omnetpp::simtime_t *timestamp2 = (newSize==0) ? nullptr : new omnetpp::simtime_t[newSize];
+    size_t minSize = timestamp_arraysize < newSize ? timestamp_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        timestamp2[i] = this->timestamp[i];
+    for (size_t i = minSize; i < newSize; i++)
+        timestamp2[i] = SIMTIME_ZERO;
+    delete [] this->timestamp;
+    this->timestamp = timestamp2;
+    timestamp_arraysize = newSize;
+}
+
+void IoTEventBatch::setTimestamp(size_t k, omnetpp::simtime_t timestamp)
+{
+    if (k >= timestamp_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)timestamp_arraysize, (unsigned long)k);
+    this->timestamp[k] = timestamp;
+}
+
+void IoTEventBatch::insertTimestamp(size_t k, omnetpp::simtime_t timestamp)
+{
+    if (k > timestamp_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)timestamp_arraysize, (unsigned long)k);
+    size_t newSize = timestamp_arraysize + 1;
+    omnetpp::simtime_t *timestamp2 = new omnetpp::simtime_t[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        timestamp2[i] = this->timestamp[i];
+    timestamp2[k] = timestamp;
+    for (i = k + 1; i < newSize; i++)
+        timestamp2[i] = this->timestamp[i-1];
+    delete [] this->timestamp;
+    this->timestamp = timestamp2;
+    timestamp_arraysize = newSize;
+}
+
+void IoTEventBatch::appendTimestamp(omnetpp::simtime_t timestamp)
+{
+    insertTimestamp(timestamp_arraysize, timestamp);
+}
+
+void IoTEventBatch::eraseTimestamp(size_t k)
+{
+    if (k >= timestamp_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)timestamp_arraysize, (unsigned long)k);
+    size_t newSize = timestamp_arraysize - 1;
+    omnetpp::simtime_t *timestamp2 = (newSize == 0) ? nullptr : new omnetpp::simtime_t[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        timestamp2[i] = this->timestamp[i];
+    for (i = k; i < newSize; i++)
+        timestamp2[i] = this->timestamp[i+1];
+    delete [] this->timestamp;
+    this->timestamp = timestamp2;
+    timestamp_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getCounterArraySize() const
+{
+    return counter_arraysize;
+}
+
+int IoTEventBatch::getCounter(size_t k) const
+{
+    if (k >= counter_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)counter_arraysize, (unsigned long)k);
+    return this->counter[k];
+}
+
+void IoTEventBatch::setCounterArraySize(size_t newSize)
+{
+    int *counter2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = counter_arraysize < newSize ? counter_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        counter2[i] = this->counter[i];
+    for (size_t i = minSize; i < newSize; i++)
+        counter2[i] = 0;
+    delete [] this->counter;
+    this->counter = counter2;
+    counter_arraysize = newSize;
+}
+
+void IoTEventBatch::setCounter(size_t k, int counter)
+{
+    if (k >= counter_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)counter_arraysize, (unsigned long)k);
+    this->counter[k] = counter;
+}
+
+void IoTEventBatch::insertCounter(size_t k, int counter)
+{
+    if (k > counter_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)counter_arraysize, (unsigned long)k);
+    size_t newSize = counter_arraysize + 1;
+    int *counter2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        counter2[i] = this->counter[i];
+    counter2[k] = counter;
+    for (i = k + 1; i < newSize; i++)
+        counter2[i] = this->counter[i-1];
+    delete [] this->counter;
+    this->counter = counter2;
+    counter_arraysize = newSize;
+}
+
+void IoTEventBatch::appendCounter(int counter)
+{
+    insertCounter(counter_arraysize, counter);
+}
+
+void IoTEventBatch::eraseCounter(size_t k)
+{
+    if (k >= counter_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)counter_arraysize, (unsigned long)k);
+    size_t newSize = counter_arraysize - 1;
+    int *counter2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        counter2[i] = this->counter[i];
+    for (i = k; i < newSize; i++)
+        counter2[i] = this->counter[i+1];
+    delete [] this->counter;
+    this->counter = counter2;
+    counter_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getTypeArraySize() const
+{
+    return type_arraysize;
+}
+
+short IoTEventBatch::getType(size_t k) const
+{
+    if (k >= type_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)type_arraysize, (unsigned long)k);
+    return this->type[k];
+}
+
+void IoTEventBatch::setTypeArraySize(size_t newSize)
+{
+    short *type2 = (newSize==0) ? nullptr : new short[newSize];
+    size_t minSize = type_arraysize < newSize ? type_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        type2[i] = this->type[i];
+    for (size_t i = minSize; i < newSize; i++)
+        type2[i] = 0;
+    delete [] this->type;
+    this->type = type2;
+    type_arraysize = newSize;
+}
+
+void IoTEventBatch::setType(size_t k, short type)
+{
+    if (k >= type_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)type_arraysize, (unsigned long)k);
+    this->type[k] = type;
+}
+
+void IoTEventBatch::insertType(size_t k, short type)
+{
+    if (k > type_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)type_arraysize, (unsigned long)k);
+    size_t newSize = type_arraysize + 1;
+    short *type2 = new short[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        type2[i] = this->type[i];
+    type2[k] = type;
+    for (i = k + 1; i < newSize; i++)
+        type2[i] = this->type[i-1];
+    delete [] this->type;
+    this->type = type2;
+    type_arraysize = newSize;
+}
+
+void IoTEventBatch::appendType(short type)
+{
+    insertType(type_arraysize, type);
+}
+
+void IoTEventBatch::eraseType(size_t k)
+{
+    if (k >= type_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)type_arraysize, (unsigned long)k);
+    size_t newSize = type_arraysize - 1;
+    short *type2 = (newSize == 0) ? nullptr : new short[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        type2[i] = this->type[i];
+    for (i = k; i < newSize; i++)
+        type2[i] = this->type[i+1];
+    delete [] this->type;
+    this->type = type2;
+    type_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getCauseOffsetArraySize() const
+{
+    return causeOffset_arraysize;
+}
+
+int IoTEventBatch::getCauseOffset(size_t k) const
+{
+    if (k >= causeOffset_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeOffset_arraysize, (unsigned long)k);
+    return this->causeOffset[k];
+}
+
+void IoTEventBatch::setCauseOffsetArraySize(size_t newSize)
+{
+    int *causeOffset2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = causeOffset_arraysize < newSize ? causeOffset_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        causeOffset2[i] = this->causeOffset[i];
+    for (size_t i = minSize; i < newSize; i++)
+        causeOffset2[i] = 0;
+    delete [] this->causeOffset;
+    this->causeOffset = causeOffset2;
+    causeOffset_arraysize = newSize;
+}
+
+void IoTEventBatch::setCauseOffset(size_t k, int causeOffset)
+{
+    if (k >= causeOffset_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeOffset_arraysize, (unsigned long)k);
+    this->causeOffset[k] = causeOffset;
+}
+
+void IoTEventBatch::insertCauseOffset(size_t k, int causeOffset)
+{
+    if (k > causeOffset_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeOffset_arraysize, (unsigned long)k);
+    size_t newSize = causeOffset_arraysize + 1;
+    int *causeOffset2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeOffset2[i] = this->causeOffset[i];
+    causeOffset2[k] = causeOffset;
+    for (i = k + 1; i < newSize; i++)
+        causeOffset2[i] = this->causeOffset[i-1];
+    delete [] this->causeOffset;
+    this->causeOffset = causeOffset2;
+    causeOffset_arraysize = newSize;
+}
+
+void IoTEventBatch::appendCauseOffset(int causeOffset)
+{
+    insertCauseOffset(causeOffset_arraysize, causeOffset);
+}
+
+void IoTEventBatch::eraseCauseOffset(size_t k)
+{
+    if (k >= causeOffset_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeOffset_arraysize, (unsigned long)k);
+    size_t newSize = causeOffset_arraysize - 1;
+    int *causeOffset2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeOffset2[i] = this->causeOffset[i];
+    for (i = k; i < newSize; i++)
+        causeOffset2[i] = this->causeOffset[i+1];
+    delete [] this->causeOffset;
+    this->causeOffset = causeOffset2;
+    causeOffset_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getCauseIndicesArraySize() const
+{
+    return causeIndices_arraysize;
+}
+
+int IoTEventBatch::getCauseIndices(size_t k) const
+{
+    if (k >= causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    return this->causeIndices[k];
+}
+
+void IoTEventBatch::setCauseIndicesArraySize(size_t newSize)
+{
+    int *causeIndices2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = causeIndices_arraysize < newSize ? causeIndices_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        causeIndices2[i] = this->causeIndices[i];
+    for (size_t i = minSize; i < newSize; i++)
+        causeIndices2[i] = 0;
+    delete [] this->causeIndices;
+    this->causeIndices = causeIndices2;
+    causeIndices_arraysize = newSize;
+}
+
+void IoTEventBatch::setCauseIndices(size_t k, int causeIndices)
+{
+    if (k >= causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    this->causeIndices[k] = causeIndices;
+}
+
+void IoTEventBatch::insertCauseIndices(size_t k, int causeIndices)
+{
+    if (k > causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    size_t newSize = causeIndices_arraysize + 1;
+    int *causeIndices2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeIndices2[i] = this->causeIndices[i];
+    causeIndices2[k] = causeIndices;
+    for (i = k + 1; i < newSize; i++)
+        causeIndices2[i] = this->causeIndices[i-1];
+    delete [] this->causeIndices;
+    this->causeIndices = causeIndices2;
+    causeIndices_arraysize = newSize;
+}
+
+void IoTEventBatch::appendCauseIndices(int causeIndices)
+{
+    insertCauseIndices(causeIndices_arraysize, causeIndices);
+}
+
+void IoTEventBatch::eraseCauseIndices(size_t k)
+{
+    if (k >= causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    size_t newSize = causeIndices_arraysize - 1;
+    int *causeIndices2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeIndices2[i] = this->causeIndices[i];
+    for (i = k; i < newSize; i++)
+        causeIndices2[i] = this->causeIndices[i+1];
+    delete [] this->causeIndices;
+    this->causeIndices = causeIndices2;
+    causeIndices_arraysize = newSize;
+}
+
+size_t IoTEventBatch::getCauseCountersArraySize() const
+{
+    return causeCounters_arraysize;
+}
+
+int IoTEventBatch::getCauseCounters(size_t k) const
+{
+    if (k >= causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    return this->causeCounters[k];
+}
+
+void IoTEventBatch::setCauseCountersArraySize(size_t newSize)
+{
+    int *causeCounters2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = causeCounters_arraysize < newSize ? causeCounters_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        causeCounters2[i] = this->causeCounters[i];
+    for (size_t i = minSize; i < newSize; i++)
+        causeCounters2[i] = 0;
+    delete [] this->causeCounters;
+    this->causeCounters = causeCounters2;
+    causeCounters_arraysize = newSize;
+}
+
+void IoTEventBatch::setCauseCounters(size_t k, int causeCounters)
+{
+    if (k >= causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    this->causeCounters[k] = causeCounters;
+}
+
+void IoTEventBatch::insertCauseCounters(size_t k, int causeCounters)
+{
+    if (k > causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    size_t newSize = causeCounters_arraysize + 1;
+    int *causeCounters2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeCounters2[i] = this->causeCounters[i];
+    causeCounters2[k] = causeCounters;
+    for (i = k + 1; i < newSize; i++)
+        causeCounters2[i] = this->causeCounters[i-1];
+    delete [] this->causeCounters;
+    this->causeCounters = causeCounters2;
+    causeCounters_arraysize = newSize;
+}
+
+void IoTEventBatch::appendCauseCounters(int causeCounters)
+{
+    insertCauseCounters(causeCounters_arraysize, causeCounters);
+}
+
+void IoTEventBatch::eraseCauseCounters(size_t k)
+{
+    if (k >= causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    size_t newSize = causeCounters_arraysize - 1;
+    int *causeCounters2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeCounters2[i] = this->causeCounters[i];
+    for (i = k; i < newSize; i++)
+        causeCounters2[i] = this->causeCounters[i+1];
+    delete [] this->causeCounters;
+    this->causeCounters = causeCounters2;
+    causeCounters_arraysize = newSize;
+}
+
+class IoTEventBatchDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_arrival,
+        FIELD_eventID,
+        FIELD_toTrigger,
+        FIELD_timestamp,
+        FIELD_counter,
+        FIELD_type,
+        FIELD_causeOffset,
+        FIELD_causeIndices,
+        FIELD_causeCounters,
+    };
+  public:
+    IoTEventBatchDescriptor();
+    virtual ~IoTEventBatchDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(IoTEventBatchDescriptor)
+
+IoTEventBatchDescriptor::IoTEventBatchDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(IoTEventBatch)), "omnetpp::cPacket")
+{
+    propertyNames = nullptr;
+}
+
+IoTEventBatchDescriptor::~IoTEventBatchDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool IoTEventBatchDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<IoTEventBatch *>(obj)!=nullptr;
+}
+
+const char **IoTEventBatchDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *IoTEventBatchDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int IoTEventBatchDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 9+base->getFieldCount() : 9;
+}
+
+unsigned int IoTEventBatchDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_arrival
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_eventID
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_toTrigger
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_timestamp
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_counter
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_type
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_causeOffset
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_causeIndices
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_causeCounters
+    };
+    return (field >= 0 && field < 9) ? fieldTypeFlags[field] : 0;
+}
+
+const char *IoTEventBatchDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "arrival",
+        "eventID",
+        "toTrigger",
+        "timestamp",
+        "counter",
+        "type",
+        "causeOffset",
+        "causeIndices",
+        "causeCounters",
+    };
+    return (field >= 0 && field < 9) ? fieldNames[field] : nullptr;
+}
+
+int IoTEventBatchDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "arrival") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "eventID") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "toTrigger") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "timestamp") == 0) return baseIndex + 3;
+    if (strcmp(fieldName, "counter") == 0) return baseIndex + 4;
+    if (strcmp(fieldName, "type") == 0) return baseIndex + 5;
+    if (strcmp(fieldName, "causeOffset") == 0) return baseIndex + 6;
+    if (strcmp(fieldName, "causeIndices") == 0) return baseIndex + 7;
+    if (strcmp(fieldName, "causeCounters") == 0) return baseIndex + 8;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *IoTEventBatchDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "omnetpp::simtime_t",    // FIELD_arrival
+        "long",    // FIELD_eventID
+        "bool",    // FIELD_toTrigger
+        "omnetpp::simtime_t",    // FIELD_timestamp
+        "int",    // FIELD_counter
+        "short",    // FIELD_type
+        "int",    // FIELD_causeOffset
+        "int",    // FIELD_causeIndices
+        "int",    // FIELD_causeCounters
+    };
+    return (field >= 0 && field < 9) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **IoTEventBatchDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *IoTEventBatchDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int IoTEventBatchDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_arrival: return pp->getArrivalArraySize();
+        case FIELD_eventID: return pp->getEventIDArraySize();
+        case FIELD_toTrigger: return pp->getToTriggerArraySize();
+        case FIELD_timestamp: return pp->getTimestampArraySize();
+        case FIELD_counter: return pp->getCounterArraySize();
+        case FIELD_type: return pp->getTypeArraySize();
+        case FIELD_causeOffset: return pp->getCauseOffsetArraySize();
+        case FIELD_causeIndices: return pp->getCauseIndicesArraySize();
+        case FIELD_causeCounters: return pp->getCauseCountersArraySize();
+        default: return 0;
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_arrival: pp->setArrivalArraySize(size); break;
+        case FIELD_eventID: pp->setEventIDArraySize(size); break;
+        case FIELD_toTrigger: pp->setToTriggerArraySize(size); break;
+        case FIELD_timestamp: pp->setTimestampArraySize(size); break;
+        case FIELD_counter: pp->setCounterArraySize(size); break;
+        case FIELD_type: pp->setTypeArraySize(size); break;
+        case FIELD_causeOffset: pp->setCauseOffsetArraySize(size); break;
+        case FIELD_causeIndices: pp->setCauseIndicesArraySize(size); break;
+        case FIELD_causeCounters: pp->setCauseCountersArraySize(size); break;
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+const char *IoTEventBatchDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string IoTEventBatchDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_arrival: return simtime2string(pp->getArrival(i));
+        case FIELD_eventID: return long2string(pp->getEventID(i));
+        case FIELD_toTrigger: return bool2string(pp->getToTrigger(i));
+        case FIELD_timestamp: return simtime2string(pp->getTimestamp(i));
+        case FIELD_counter: return long2string(pp->getCounter(i));
+        case FIELD_type: return long2string(pp->getType(i));
+        case FIELD_causeOffset: return long2string(pp->getCauseOffset(i));
+        case FIELD_causeIndices: return long2string(pp->getCauseIndices(i));
+        case FIELD_causeCounters: return long2string(pp->getCauseCounters(i));
+        default: return "";
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_arrival: pp->setArrival(i,string2simtime(value)); break;
+        case FIELD_eventID: pp->setEventID(i,string2long(value)); break;
+        case FIELD_toTrigger: pp->setToTrigger(i,string2bool(value)); break;
+        case FIELD_timestamp: pp->setTimestamp(i,string2simtime(value)); break;
+        case FIELD_counter: pp->setCounter(i,string2long(value)); break;
+        case FIELD_type: pp->setType(i,string2long(value)); break;
+        case FIELD_causeOffset: pp->setCauseOffset(i,string2long(value)); break;
+        case FIELD_causeIndices: pp->setCauseIndices(i,string2long(value)); break;
+        case FIELD_causeCounters: pp->setCauseCounters(i,string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+omnetpp::cValue IoTEventBatchDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_arrival: return pp->getArrival(i).dbl();
+        case FIELD_eventID: return (omnetpp::intval_t)(pp->getEventID(i));
+        case FIELD_toTrigger: return pp->getToTrigger(i);
+        case FIELD_timestamp: return pp->getTimestamp(i).dbl();
+        case FIELD_counter: return pp->getCounter(i);
+        case FIELD_type: return pp->getType(i);
+        case FIELD_causeOffset: return pp->getCauseOffset(i);
+        case FIELD_causeIndices: return pp->getCauseIndices(i);
+        case FIELD_causeCounters: return pp->getCauseCounters(i);
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'IoTEventBatch' as cValue -- field index out of range?", field);
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_arrival: pp->setArrival(i,value.doubleValue()); break;
+        case FIELD_eventID: pp->setEventID(i,omnetpp::checked_int_cast<long>(value.intValue())); break;
+        case FIELD_toTrigger: pp->setToTrigger(i,value.boolValue()); break;
+        case FIELD_timestamp: pp->setTimestamp(i,value.doubleValue()); break;
+        case FIELD_counter: pp->setCounter(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_type: pp->setType(i,omnetpp::checked_int_cast<short>(value.intValue())); break;
+        case FIELD_causeOffset: pp->setCauseOffset(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_causeIndices: pp->setCauseIndices(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_causeCounters: pp->setCauseCounters(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+const char *IoTEventBatchDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr IoTEventBatchDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+namespace omnetpp {
+
+}  // namespace omnetpp
+
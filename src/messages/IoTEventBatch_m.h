@@ -0,0 +1,167 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.0 from messages/IoTEventBatch.msg.
+//
+
+#ifndef __IOTEVENTBATCH_M_H
+#define __IOTEVENTBATCH_M_H
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wreserved-id-macro"
+#endif
+#include <omnetpp.h>
+
+// opp_msgtool version check
+#define MSGC_VERSION 0x0600
+#if (MSGC_VERSION!=OMNETPP_VERSION)
+#    error Version mismatch! Probably this file was generated by an earlier version of opp_msgtool: 'make clean' should help.
+#endif
+
+class IoTEventBatch;
+/**
+ * Class generated from <tt>messages/IoTEventBatch.msg:22</tt> by opp_msgtool.
+ * <pre>
+ * packet IoTEventBatch
+ * {
+ *     simtime_t arrival[];
+ *     long eventID[];
+ *     bool toTrigger[];
+ *     simtime_t timestamp[];
+ *     int counter[];
+ *     short type[];
+ *     int causeOffset[];
+ *     int causeIndices[];
+ *     int causeCounters[];
+ * }
+ * </pre>
+ */
+class IoTEventBatch : public ::omnetpp::cPacket
+{
+  protected:
+    omnetpp::simtime_t *arrival = nullptr;
+    size_t arrival_arraysize = 0;
+    long *eventID = nullptr;
+    size_t eventID_arraysize = 0;
+    bool *toTrigger = nullptr;
+    size_t toTrigger_arraysize = 0;
+    omnetpp::simtime_t *timestamp = nullptr;
+    size_t timestamp_arraysize = 0;
+    int *counter = nullptr;
+    size_t counter_arraysize = 0;
+    short *type = nullptr;
+    size_t type_arraysize = 0;
+    int *causeOffset = nullptr;
+    size_t causeOffset_arraysize = 0;
+    int *causeIndices = nullptr;
+    size_t causeIndices_arraysize = 0;
+    int *causeCounters = nullptr;
+    size_t causeCounters_arraysize = 0;
+
+  private:
+    void copy(const IoTEventBatch& other);
+
+  protected:
+    bool operator==(const IoTEventBatch&) = delete;
+
+  public:
+    IoTEventBatch(const char *name=nullptr, short kind=0);
+    IoTEventBatch(const IoTEventBatch& other);
+    virtual ~IoTEventBatch();
+    IoTEventBatch& operator=(const IoTEventBatch& other);
+    virtual IoTEventBatch *dup() const override {return new IoTEventBatch(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual void setArrivalArraySize(size_t size);
+    virtual size_t getArrivalArraySize() const;
+    virtual omnetpp::simtime_t getArrival(size_t k) const;
+    virtual void setArrival(size_t k, omnetpp::simtime_t arrival);
+    virtual void insertArrival(size_t k, omnetpp::simtime_t arrival);
+    [[deprecated]] void insertArrival(omnetpp::simtime_t arrival) {appendArrival(arrival);}
+    virtual void appendArrival(omnetpp::simtime_t arrival);
+    virtual void eraseArrival(size_t k);
+
+    virtual void setEventIDArraySize(size_t size);
+    virtual size_t getEventIDArraySize() const;
+    virtual long getEventID(size_t k) const;
+    virtual void setEventID(size_t k, long eventID);
+    virtual void insertEventID(size_t k, long eventID);
+    [[deprecated]] void insertEventID(long eventID) {appendEventID(eventID);}
+    virtual void appendEventID(long eventID);
+    virtual void eraseEventID(size_t k);
+
+    virtual void setToTriggerArraySize(size_t size);
+    virtual size_t getToTriggerArraySize() const;
+    virtual bool getToTrigger(size_t k) const;
+    virtual void setToTrigger(size_t k, bool toTrigger);
+    virtual void insertToTrigger(size_t k, bool toTrigger);
+    [[deprecated]] void insertToTrigger(bool toTrigger) {appendToTrigger(toTrigger);}
+    virtual void appendToTrigger(bool toTrigger);
+    virtual void eraseToTrigger(size_t k);
+
+    virtual void setTimestampArraySize(size_t size);
+    virtual size_t getTimestampArraySize() const;
+    virtual omnetpp::simtime_t getTimestamp(size_t k) const;
+    virtual void setTimestamp(size_t k, omnetpp::simtime_t timestamp);
+    virtual void insertTimestamp(size_t k, omnetpp::simtime_t timestamp);
+    [[deprecated]] void insertTimestamp(omnetpp::simtime_t timestamp) {appendTimestamp(timestamp);}
+    virtual void appendTimestamp(omnetpp::simtime_t timestamp);
+    virtual void eraseTimestamp(size_t k);
+
+    virtual void setCounterArraySize(size_t size);
+    virtual size_t getCounterArraySize() const;
+    virtual int getCounter(size_t k) const;
+    virtual void setCounter(size_t k, int counter);
+    virtual void insertCounter(size_t k, int counter);
+    [[deprecated]] void insertCounter(int counter) {appendCounter(counter);}
+    virtual void appendCounter(int counter);
+    virtual void eraseCounter(size_t k);
+
+    virtual void setTypeArraySize(size_t size);
+    virtual size_t getTypeArraySize() const;
+    virtual short getType(size_t k) const;
+    virtual void setType(size_t k, short type);
+    virtual void insertType(size_t k, short type);
+    [[deprecated]] void insertType(short type) {appendType(type);}
+    virtual void appendType(short type);
+    virtual void eraseType(size_t k);
+
+    virtual void setCauseOffsetArraySize(size_t size);
+    virtual size_t getCauseOffsetArraySize() const;
+    virtual int getCauseOffset(size_t k) const;
+    virtual void setCauseOffset(size_t k, int causeOffset);
+    virtual void insertCauseOffset(size_t k, int causeOffset);
+    [[deprecated]] void insertCauseOffset(int causeOffset) {appendCauseOffset(causeOffset);}
+    virtual void appendCauseOffset(int causeOffset);
+    virtual void eraseCauseOffset(size_t k);
+
+    virtual void setCauseIndicesArraySize(size_t size);
+    virtual size_t getCauseIndicesArraySize() const;
+    virtual int getCauseIndices(size_t k) const;
+    virtual void setCauseIndices(size_t k, int causeIndices);
+    virtual void insertCauseIndices(size_t k, int causeIndices);
+    [[deprecated]] void insertCauseIndices(int causeIndices) {appendCauseIndices(causeIndices);}
+    virtual void appendCauseIndices(int causeIndices);
+    virtual void eraseCauseIndices(size_t k);
+
+    virtual void setCauseCountersArraySize(size_t size);
+    virtual size_t getCauseCountersArraySize() const;
+    virtual int getCauseCounters(size_t k) const;
+    virtual void setCauseCounters(size_t k, int causeCounters);
+    virtual void insertCauseCounters(size_t k, int causeCounters);
+    [[deprecated]] void insertCauseCounters(int causeCounters) {appendCauseCounters(causeCounters);}
+    virtual void appendCauseCounters(int causeCounters);
+    virtual void eraseCauseCounters(size_t k);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const IoTEventBatch& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, IoTEventBatch& obj) {obj.parsimUnpack(b);}
+
+
+namespace omnetpp {
+
+template<> inline IoTEventBatch *fromAnyPtr(any_ptr ptr) { return check_and_cast<IoTEventBatch*>(ptr.get<cObject>()); }
+
+}  // namespace omnetpp
+
+#endif // ifndef __IOTEVENTBATCH_M_H
+
@@ -163,6 +163,8 @@ IoTEvent::IoTEvent(const IoTEvent& other) : ::omnetpp::cPacket(other)
 
 IoTEvent::~IoTEvent()
 {
+    delete [] this->causeIndices;
+    delete [] this->causeCounters;
 }
 
 IoTEvent& IoTEvent::operator=(const IoTEvent& other)
@@ -179,7 +181,18 @@ void IoTEvent::copy(const IoTEvent& other)
     this->toTrigger = other.toTrigger;
     this->timestamp = other.timestamp;
     this->counter = other.counter;
-    this->causeCounts = other.causeCounts;
+    delete [] this->causeIndices;
+    this->causeIndices = (other.causeIndices_arraysize==0) ? nullptr : new int[other.causeIndices_arraysize];
+    causeIndices_arraysize = other.causeIndices_arraysize;
+    for (size_t i = 0; i < causeIndices_arraysize; i++) {
+        this->causeIndices[i] = other.causeIndices[i];
+    }
+    delete [] this->causeCounters;
+    this->causeCounters = (other.causeCounters_arraysize==0) ? nullptr : new int[other.causeCounters_arraysize];
+    causeCounters_arraysize = other.causeCounters_arraysize;
+    for (size_t i = 0; i < causeCounters_arraysize; i++) {
+        this->causeCounters[i] = other.causeCounters[i];
+    }
     this->type = other.type;
 }
 
@@ -190,7 +203,10 @@ void IoTEvent::parsimPack(omnetpp::cCommBuffer *b) const
     doParsimPacking(b,this->toTrigger);
     doParsimPacking(b,this->timestamp);
     doParsimPacking(b,this->counter);
-    doParsimPacking(b,this->causeCounts);
+    b->pack(causeIndices_arraysize);
+    doParsimArrayPacking(b,this->causeIndices,causeIndices_arraysize);
+    b->pack(causeCounters_arraysize);
+    doParsimArrayPacking(b,this->causeCounters,causeCounters_arraysize);
     doParsimPacking(b,this->type);
 }
 
@@ -201,7 +217,22 @@ void IoTEvent::parsimUnpack(omnetpp::cCommBuffer *b)
     doParsimUnpacking(b,this->toTrigger);
     doParsimUnpacking(b,this->timestamp);
     doParsimUnpacking(b,this->counter);
-    doParsimUnpacking(b,this->causeCounts);
+    delete [] this->causeIndices;
+    b->unpack(causeIndices_arraysize);
+    if (causeIndices_arraysize == 0) {
+        this->causeIndices = nullptr;
+    } else {
+        this->causeIndices = new int[causeIndices_arraysize];
+        doParsimArrayUnpacking(b,this->causeIndices,causeIndices_arraysize);
+    }
+    delete [] this->causeCounters;
+    b->unpack(causeCounters_arraysize);
+    if (causeCounters_arraysize == 0) {
+        this->causeCounters = nullptr;
+    } else {
+        this->causeCounters = new int[causeCounters_arraysize];
+        doParsimArrayUnpacking(b,this->causeCounters,causeCounters_arraysize);
+    }
     doParsimUnpacking(b,this->type);
 }
 
@@ -245,14 +276,136 @@ void IoTEvent::setCounter(int counter)
     this->counter = counter;
 }
 
-const char * IoTEvent::getCauseCounts() const
+size_t IoTEvent::getCauseIndicesArraySize() const
+{
+    return causeIndices_arraysize;
+}
+
+int IoTEvent::getCauseIndices(size_t k) const
+{
+    if (k >= causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    return this->causeIndices[k];
+}
+
+void IoTEvent::setCauseIndicesArraySize(size_t newSize)
+{
+    int *causeIndices2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = causeIndices_arraysize < newSize ? causeIndices_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        causeIndices2[i] = this->causeIndices[i];
+    for (size_t i = minSize; i < newSize; i++)
+        causeIndices2[i] = 0;
+    delete [] this->causeIndices;
+    this->causeIndices = causeIndices2;
+    causeIndices_arraysize = newSize;
+}
+
+void IoTEvent::setCauseIndices(size_t k, int causeIndices)
+{
+    if (k >= causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    this->causeIndices[k] = causeIndices;
+}
+
+void IoTEvent::insertCauseIndices(size_t k, int causeIndices)
+{
+    if (k > causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    size_t newSize = causeIndices_arraysize + 1;
+    int *causeIndices2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeIndices2[i] = this->causeIndices[i];
+    causeIndices2[k] = causeIndices;
+    for (i = k + 1; i < newSize; i++)
+        causeIndices2[i] = this->causeIndices[i-1];
+    delete [] this->causeIndices;
+    this->causeIndices = causeIndices2;
+    causeIndices_arraysize = newSize;
+}
+
+void IoTEvent::appendCauseIndices(int causeIndices)
+{
+    insertCauseIndices(causeIndices_arraysize, causeIndices);
+}
+
+void IoTEvent::eraseCauseIndices(size_t k)
+{
+    if (k >= causeIndices_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeIndices_arraysize, (unsigned long)k);
+    size_t newSize = causeIndices_arraysize - 1;
+    int *causeIndices2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeIndices2[i] = this->causeIndices[i];
+    for (i = k; i < newSize; i++)
+        causeIndices2[i] = this->causeIndices[i+1];
+    delete [] this->causeIndices;
+    this->causeIndices = causeIndices2;
+    causeIndices_arraysize = newSize;
+}
+
+size_t IoTEvent::getCauseCountersArraySize() const
+{
+    return causeCounters_arraysize;
+}
+
+int IoTEvent::getCauseCounters(size_t k) const
+{
+    if (k >= causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    return this->causeCounters[k];
+}
+
+void IoTEvent::setCauseCountersArraySize(size_t newSize)
+{
+    int *causeCounters2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = causeCounters_arraysize < newSize ? causeCounters_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        causeCounters2[i] = this->causeCounters[i];
+    for (size_t i = minSize; i < newSize; i++)
+        causeCounters2[i] = 0;
+    delete [] this->causeCounters;
+    this->causeCounters = causeCounters2;
+    causeCounters_arraysize = newSize;
+}
+
+void IoTEvent::setCauseCounters(size_t k, int causeCounters)
+{
+    if (k >= causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    this->causeCounters[k] = causeCounters;
+}
+
+void IoTEvent::insertCauseCounters(size_t k, int causeCounters)
+{
+    if (k > causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    size_t newSize = causeCounters_arraysize + 1;
+    int *causeCounters2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeCounters2[i] = this->causeCounters[i];
+    causeCounters2[k] = causeCounters;
+    for (i = k + 1; i < newSize; i++)
+        causeCounters2[i] = this->causeCounters[i-1];
+    delete [] this->causeCounters;
+    this->causeCounters = causeCounters2;
+    causeCounters_arraysize = newSize;
+}
+
+void IoTEvent::appendCauseCounters(int causeCounters)
 {
-    return this->causeCounts.c_str();
+    insertCauseCounters(causeCounters_arraysize, causeCounters);
 }
 
-void IoTEvent::setCauseCounts(const char * causeCounts)
+void IoTEvent::eraseCauseCounters(size_t k)
 {
-    this->causeCounts = causeCounts;
+    if (k >= causeCounters_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)causeCounters_arraysize, (unsigned long)k);
+    size_t newSize = causeCounters_arraysize - 1;
+    int *causeCounters2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        causeCounters2[i] = this->causeCounters[i];
+    for (i = k; i < newSize; i++)
+        causeCounters2[i] = this->causeCounters[i+1];
+    delete [] this->causeCounters;
+    this->causeCounters = causeCounters2;
+    causeCounters_arraysize = newSize;
 }
 
 short IoTEvent::getType() const
@@ -274,7 +427,8 @@ class IoTEventDescriptor : public omnetpp::cClassDescriptor
         FIELD_toTrigger,
         FIELD_timestamp,
         FIELD_counter,
-        FIELD_causeCounts,
+        FIELD_causeIndices,
+        FIELD_causeCounters,
         FIELD_type,
     };
   public:
@@ -342,7 +496,7 @@ const char *IoTEventDescriptor::getProperty(const char *propertyName) const
 int IoTEventDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
-    return base ? 6+base->getFieldCount() : 6;
+    return base ? 7+base->getFieldCount() : 7;
 }
 
 unsigned int IoTEventDescriptor::getFieldTypeFlags(int field) const
@@ -358,10 +512,11 @@ unsigned int IoTEventDescriptor::getFieldTypeFlags(int field) const
         FD_ISEDITABLE,    // FIELD_toTrigger
         FD_ISEDITABLE,    // FIELD_timestamp
         FD_ISEDITABLE,    // FIELD_counter
-        FD_ISEDITABLE,    // FIELD_causeCounts
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_causeIndices
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_causeCounters
         FD_ISEDITABLE,    // FIELD_type
     };
-    return (field >= 0 && field < 6) ? fieldTypeFlags[field] : 0;
+    return (field >= 0 && field < 7) ? fieldTypeFlags[field] : 0;
 }
 
 const char *IoTEventDescriptor::getFieldName(int field) const
@@ -377,10 +532,11 @@ const char *IoTEventDescriptor::getFieldName(int field) const
         "toTrigger",
         "timestamp",
         "counter",
-        "causeCounts",
+        "causeIndices",
+        "causeCounters",
         "type",
     };
-    return (field >= 0 && field < 6) ? fieldNames[field] : nullptr;
+    return (field >= 0 && field < 7) ? fieldNames[field] : nullptr;
 }
 
 int IoTEventDescriptor::findField(const char *fieldName) const
@@ -391,8 +547,9 @@ int IoTEventDescriptor::findField(const char *fieldName) const
     if (strcmp(fieldName, "toTrigger") == 0) return baseIndex + 1;
     if (strcmp(fieldName, "timestamp") == 0) return baseIndex + 2;
     if (strcmp(fieldName, "counter") == 0) return baseIndex + 3;
-    if (strcmp(fieldName, "causeCounts") == 0) return baseIndex + 4;
-    if (strcmp(fieldName, "type") == 0) return baseIndex + 5;
+    if (strcmp(fieldName, "causeIndices") == 0) return baseIndex + 4;
+    if (strcmp(fieldName, "causeCounters") == 0) return baseIndex + 5;
+    if (strcmp(fieldName, "type") == 0) return baseIndex + 6;
     return base ? base->findField(fieldName) : -1;
 }
 
@@ -409,10 +566,11 @@ const char *IoTEventDescriptor::getFieldTypeString(int field) const
         "bool",    // FIELD_toTrigger
         "omnetpp::simtime_t",    // FIELD_timestamp
         "int",    // FIELD_counter
-        "string",    // FIELD_causeCounts
+        "int",    // FIELD_causeIndices
+        "int",    // FIELD_causeCounters
         "short",    // FIELD_type
     };
-    return (field >= 0 && field < 6) ? fieldTypeStrings[field] : nullptr;
+    return (field >= 0 && field < 7) ? fieldTypeStrings[field] : nullptr;
 }
 
 const char **IoTEventDescriptor::getFieldPropertyNames(int field) const
@@ -451,6 +609,8 @@ int IoTEventDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) co
     }
     IoTEvent *pp = omnetpp::fromAnyPtr<IoTEvent>(object); (void)pp;
     switch (field) {
+        case FIELD_causeIndices: return pp->getCauseIndicesArraySize();
+        case FIELD_causeCounters: return pp->getCauseCountersArraySize();
         default: return 0;
     }
 }
@@ -467,6 +627,8 @@ void IoTEventDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, i
     }
     IoTEvent *pp = omnetpp::fromAnyPtr<IoTEvent>(object); (void)pp;
     switch (field) {
+        case FIELD_causeIndices: pp->setCauseIndicesArraySize(size); break;
+        case FIELD_causeCounters: pp->setCauseCountersArraySize(size); break;
         default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'IoTEvent'", field);
     }
 }
@@ -499,7 +661,8 @@ std::string IoTEventDescriptor::getFieldValueAsString(omnetpp::any_ptr object, i
         case FIELD_toTrigger: return bool2string(pp->getToTrigger());
         case FIELD_timestamp: return simtime2string(pp->getTimestamp());
         case FIELD_counter: return long2string(pp->getCounter());
-        case FIELD_causeCounts: return oppstring2string(pp->getCauseCounts());
+        case FIELD_causeIndices: return long2string(pp->getCauseIndices(i));
+        case FIELD_causeCounters: return long2string(pp->getCauseCounters(i));
         case FIELD_type: return long2string(pp->getType());
         default: return "";
     }
@@ -521,7 +684,8 @@ void IoTEventDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int fiel
         case FIELD_toTrigger: pp->setToTrigger(string2bool(value)); break;
         case FIELD_timestamp: pp->setTimestamp(string2simtime(value)); break;
         case FIELD_counter: pp->setCounter(string2long(value)); break;
-        case FIELD_causeCounts: pp->setCauseCounts((value)); break;
+        case FIELD_causeIndices: pp->setCauseIndices(i,string2long(value)); break;
+        case FIELD_causeCounters: pp->setCauseCounters(i,string2long(value)); break;
         case FIELD_type: pp->setType(string2long(value)); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEvent'", field);
     }
@@ -541,7 +705,8 @@ omnetpp::cValue IoTEventDescriptor::getFieldValue(omnetpp::any_ptr object, int f
         case FIELD_toTrigger: return pp->getToTrigger();
         case FIELD_timestamp: return pp->getTimestamp().dbl();
         case FIELD_counter: return pp->getCounter();
-        case FIELD_causeCounts: return pp->getCauseCounts();
+        case FIELD_causeIndices: return pp->getCauseIndices(i);
+        case FIELD_causeCounters: return pp->getCauseCounters(i);
         case FIELD_type: return pp->getType();
         default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'IoTEvent' as cValue -- field index out of range?", field);
     }
@@ -563,7 +728,8 @@ void IoTEventDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i
         case FIELD_toTrigger: pp->setToTrigger(value.boolValue()); break;
         case FIELD_timestamp: pp->setTimestamp(value.doubleValue()); break;
         case FIELD_counter: pp->setCounter(omnetpp::checked_int_cast<int>(value.intValue())); break;
-        case FIELD_causeCounts: pp->setCauseCounts(value.stringValue()); break;
+        case FIELD_causeIndices: pp->setCauseIndices(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_causeCounters: pp->setCauseCounters(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
         case FIELD_type: pp->setType(omnetpp::checked_int_cast<short>(value.intValue())); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEvent'", field);
     }
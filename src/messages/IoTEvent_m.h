@@ -26,7 +26,8 @@ class IoTEvent;
  *     bool toTrigger;
  *     simtime_t timestamp;
  *     int counter;
- *     string causeCounts;
+ *     int causeIndices[];
+ *     int causeCounters[];
  *     short type;
  * }
  * </pre>
@@ -38,7 +39,10 @@ class IoTEvent : public ::omnetpp::cPacket
     bool toTrigger = false;
     omnetpp::simtime_t timestamp = SIMTIME_ZERO;
     int counter = 0;
-    omnetpp::opp_string causeCounts;
+    int *causeIndices = nullptr;
+    size_t causeIndices_arraysize = 0;
+    int *causeCounters = nullptr;
+    size_t causeCounters_arraysize = 0;
     short type = 0;
 
   private:
@@ -68,8 +72,23 @@ class IoTEvent : public ::omnetpp::cPacket
     virtual int getCounter() const;
     virtual void setCounter(int counter);
 
-    virtual const char * getCauseCounts() const;
-    virtual void setCauseCounts(const char * causeCounts);
+    virtual void setCauseIndicesArraySize(size_t size);
+    virtual size_t getCauseIndicesArraySize() const;
+    virtual int getCauseIndices(size_t k) const;
+    virtual void setCauseIndices(size_t k, int causeIndices);
+    virtual void insertCauseIndices(size_t k, int causeIndices);
+    [[deprecated]] void insertCauseIndices(int causeIndices) {appendCauseIndices(causeIndices);}
+    virtual void appendCauseIndices(int causeIndices);
+    virtual void eraseCauseIndices(size_t k);
+
+    virtual void setCauseCountersArraySize(size_t size);
+    virtual size_t getCauseCountersArraySize() const;
+    virtual int getCauseCounters(size_t k) const;
+    virtual void setCauseCounters(size_t k, int causeCounters);
+    virtual void insertCauseCounters(size_t k, int causeCounters);
+    [[deprecated]] void insertCauseCounters(int causeCounters) {appendCauseCounters(causeCounters);}
+    virtual void appendCauseCounters(int causeCounters);
+    virtual void eraseCauseCounters(size_t k);
 
     virtual short getType() const;
     virtual void setType(short type);
@@ -0,0 +1,136 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "AlignmentFidelity.h"
+
+AlignmentFidelity::AlignmentFidelity() {
+    horizon = 300;
+    sumSqrMaxDiff = 0;
+    numOfInstances = 0;
+}
+
+AlignmentFidelity::~AlignmentFidelity() {
+    // TODO Auto-generated destructor stub
+}
+
+void AlignmentFidelity::setHorizon(simtime_t horizon) {
+    this->horizon = horizon;
+}
+
+void AlignmentFidelity::_compare(const map<int, int> &simCauseCounts,
+        const map<int, int> *actCauseCounts) {
+    int maxDiff = -1;
+    for (auto &causeCount : simCauseCounts) {
+        int actCount = 0;
+        if (actCauseCounts != nullptr) {
+            auto it = actCauseCounts->find(causeCount.first);
+            if (it != actCauseCounts->end()) {
+                actCount = it->second;
+            }
+        }
+        maxDiff = std::max(maxDiff, abs(causeCount.second - actCount));
+    }
+    // an instance without causes is aligned
+    if (maxDiff > 0) {
+        sumSqrMaxDiff += pow(maxDiff, 2);
+    }
+    numOfInstances++;
+}
+
+void AlignmentFidelity::_record(bool isSimulated, const si_id &instance,
+        const cause_counts &causeCounts, simtime_t current) {
+    map<si_id, Instance> &pending = isSimulated ? simulated : actual;
+    map<si_id, Instance> &counterpart = isSimulated ? actual : simulated;
+    // a cause listed more than once keeps its last counter
+    map<int, int> counts;
+    for (auto &causeCount : causeCounts) {
+        counts[causeCount.first] = causeCount.second;
+    }
+
+    /*
+     * 1. Compare the instance with its counterpart if already recorded, and evict both
+     */
+    auto it = counterpart.find(instance);
+    if (it != counterpart.end()) {
+        if (isSimulated) {
+            _compare(counts, &it->second.causeCounts);
+        } else {
+            _compare(it->second.causeCounts, &counts);
+        }
+        counterpart.erase(it);
+        return;
+    }
+
+    /*
+     * 2. Otherwise keep it until the counterpart is recorded, a newer recording of the
+     * same instance replacing the older one
+     */
+    Instance &entry = pending[instance];
+    entry.recorded = current;
+    entry.causeCounts.swap(counts);
+    recordings.push_back(std::make_tuple(current, isSimulated, instance));
+}
+
+void AlignmentFidelity::recordActual(const si_id &instance,
+        const cause_counts &causeCounts, simtime_t current) {
+    _record(false, instance, causeCounts, current);
+}
+
+void AlignmentFidelity::recordSimulated(const si_id &instance,
+        const cause_counts &causeCounts, simtime_t current) {
+    _record(true, instance, causeCounts, current);
+}
+
+void AlignmentFidelity::evict(simtime_t current) {
+    while (!recordings.empty() && std::get<0>(recordings.front()) + horizon < current) {
+        bool isSimulated = std::get<1>(recordings.front());
+        si_id instance = std::get<2>(recordings.front());
+        recordings.pop_front();
+
+        /*
+         * A recording is stale if the instance has been matched or recorded again since
+         */
+        map<si_id, Instance> &pending = isSimulated ? simulated : actual;
+        auto it = pending.find(instance);
+        if (it == pending.end() || it->second.recorded + horizon >= current) {
+            continue;
+        }
+        if (isSimulated) {
+            _compare(it->second.causeCounts, nullptr);
+        }
+        pending.erase(it);
+    }
+}
+
+void AlignmentFidelity::settle() {
+    for (auto &entry : simulated) {
+        _compare(entry.second.causeCounts, nullptr);
+    }
+    simulated.clear();
+    actual.clear();
+    recordings.clear();
+}
+
+double AlignmentFidelity::getFidelity() {
+    return sqrt(sumSqrMaxDiff / (double) numOfInstances);
+}
+
+long AlignmentFidelity::numOfCompared() {
+    return numOfInstances;
+}
+
+size_t AlignmentFidelity::numOfPending() {
+    return actual.size() + simulated.size();
+}
@@ -0,0 +1,80 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_ALIGNMENTFIDELITY_H_
+#define OBJECTS_ALIGNMENTFIDELITY_H_
+
+#include <map>
+#include <deque>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <omnetpp.h>
+
+using namespace std;
+using namespace omnetpp;
+
+/*
+ * Streaming situation alignment fidelity. An actual and a simulated instance of the
+ * same situation, i.e., the same <situation_id, counter>, are compared once both are
+ * recorded with their <cause index, cause counter> pairs, where a cause index is the
+ * dense index of the cause situation in the model. The largest difference between
+ * their cause counters is added to a sum of squares, and both are evicted. An instance
+ * left unmatched for longer than the horizon is settled on its own, where a simulated
+ * one is compared to zero cause counters and an actual one is dropped.
+ */
+class AlignmentFidelity {
+public:
+    // situation instance ID: <situation_id, counter>
+    typedef std::pair<long, int> si_id;
+    // <cause index, cause counter> pairs of an instance
+    typedef std::vector<std::pair<int, int>> cause_counts;
+private:
+    struct Instance {
+        simtime_t recorded;
+        // <cause index, cause counter>
+        map<int, int> causeCounts;
+    };
+    simtime_t horizon;
+    map<si_id, Instance> actual;
+    map<si_id, Instance> simulated;
+    // <recorded time, simulated?, instance> in order of recording, for eviction
+    deque<std::tuple<simtime_t, bool, si_id>> recordings;
+    double sumSqrMaxDiff;
+    long numOfInstances;
+
+    void _compare(const map<int, int> &simCauseCounts,
+            const map<int, int> *actCauseCounts);
+    void _record(bool isSimulated, const si_id &instance,
+            const cause_counts &causeCounts, simtime_t current);
+public:
+    AlignmentFidelity();
+    void setHorizon(simtime_t horizon);
+    void recordActual(const si_id &instance, const cause_counts &causeCounts,
+            simtime_t current);
+    void recordSimulated(const si_id &instance, const cause_counts &causeCounts,
+            simtime_t current);
+    // settle the instances unmatched since before current - horizon
+    void evict(simtime_t current);
+    // settle all unmatched instances, e.g., at the end of the simulation
+    void settle();
+    // root mean square of the largest cause counter difference of each simulated instance
+    double getFidelity();
+    long numOfCompared();
+    size_t numOfPending();
+    virtual ~AlignmentFidelity();
+};
+
+#endif /* OBJECTS_ALIGNMENTFIDELITY_H_ */
@@ -0,0 +1,251 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <algorithm>
+#include "ArithmeticCircuit.h"
+
+ArithmeticCircuit::ArithmeticCircuit() {
+    output = -1;
+    numOfNodes = 0;
+    stale = true;
+}
+
+ArithmeticCircuit::~ArithmeticCircuit() {
+    // TODO Auto-generated destructor stub
+}
+
+void ArithmeticCircuit::BuildNetwork(long node_count,
+        const std::vector<FactorizedCPT> &cpts) {
+    /*
+     * The junction tree is only needed to compile the circuit
+     */
+    JunctionTree jt;
+    jt.BuildNetwork(node_count, cpts);
+    numOfNodes = node_count;
+    evidences.assign(node_count, -1);
+    _compile(jt);
+    stale = true;
+}
+
+int ArithmeticCircuit::_addNode(Kind kind, double coefficient,
+        const vector<int> &arguments) {
+    kinds.push_back(kind);
+    values.push_back(kind == CONSTANT ? coefficient : 1);
+    coefficients.push_back(coefficient);
+    args.insert(args.end(), arguments.begin(), arguments.end());
+    offsets.push_back(args.size());
+    return kinds.size() - 1;
+}
+
+void ArithmeticCircuit::_compile(const JunctionTree &jt) {
+    kinds.clear();
+    values.clear();
+    coefficients.clear();
+    offsets.assign(1, 0);
+    args.clear();
+    blocks.clear();
+
+    int zero = _addNode(CONSTANT, 0, vector<int>());
+    indicators.resize(2 * numOfNodes);
+    for (long v = 0; v < numOfNodes; v++) {
+        indicators[2 * v] = _addNode(INDICATOR, 1, vector<int>());
+        indicators[2 * v + 1] = _addNode(INDICATOR, 1, vector<int>());
+    }
+
+    /*
+     * One block per clique, children first. Entries with a zero CPT product are
+     * left out, and so are those multiplied by a message that is always zero.
+     */
+    vector<vector<int>> messages(jt.cliques.size());
+    vector<int> roots;
+    vector<int> arguments;
+    for (long c : jt.order) {
+        const JunctionTree::Clique &clique = jt.cliques[c];
+        Block block;
+        block.begin = kinds.size();
+        vector<int> entries(clique.base.size(), -1);
+        for (size_t i = 0; i < clique.base.size(); i++) {
+            if (clique.base[i] == 0) {
+                continue;
+            }
+            arguments.clear();
+            if (c < numOfNodes) {
+                arguments.push_back(indicators[2 * c + ((i >> clique.pivot) & 1)]);
+            }
+            bool alwaysZero = false;
+            for (long k : clique.children) {
+                int message = messages[k][jt.cliques[k].parentMap[i]];
+                alwaysZero = alwaysZero || message == zero;
+                arguments.push_back(message);
+            }
+            if (!alwaysZero) {
+                entries[i] = _addNode(PRODUCT, clique.base[i], arguments);
+            }
+        }
+
+        block.sums = kinds.size();
+        size_t low = (1 << clique.pivot) - 1;
+        messages[c].resize(clique.base.size() / 2);
+        for (size_t s = 0; s < messages[c].size(); s++) {
+            size_t i = ((s & ~low) << 1) | (s & low);
+            arguments.clear();
+            if (entries[i] >= 0) {
+                arguments.push_back(entries[i]);
+            }
+            if (entries[i | (low + 1)] >= 0) {
+                arguments.push_back(entries[i | (low + 1)]);
+            }
+            messages[c][s] =
+                    arguments.empty() ? zero : _addNode(SUM, 0, arguments);
+        }
+        block.end = kinds.size();
+        blocks.push_back(block);
+
+        if (clique.parent < 0) {
+            roots.push_back(messages[c][0]);
+        }
+    }
+    output = _addNode(PRODUCT, 1, roots);
+
+    derivatives.assign(kinds.size(), 0);
+    nonZero.assign(kinds.size(), 0);
+    zeros.assign(kinds.size(), 0);
+}
+
+void ArithmeticCircuit::_evaluate(int node) {
+    if (kinds[node] == SUM) {
+        double sum = 0;
+        for (int a = offsets[node]; a < offsets[node + 1]; a++) {
+            sum += values[args[a]];
+        }
+        values[node] = sum;
+    } else if (kinds[node] == PRODUCT) {
+        double product = coefficients[node];
+        int count = 0;
+        for (int a = offsets[node]; a < offsets[node + 1]; a++) {
+            double value = values[args[a]];
+            if (value == 0) {
+                count++;
+            } else {
+                product *= value;
+            }
+        }
+        nonZero[node] = product;
+        zeros[node] = count;
+        values[node] = count > 0 ? 0 : product;
+    }
+}
+
+void ArithmeticCircuit::_differentiate(int node) {
+    double d = derivatives[node];
+    if (d == 0) {
+        return;
+    }
+    if (kinds[node] == SUM) {
+        for (int a = offsets[node]; a < offsets[node + 1]; a++) {
+            derivatives[args[a]] += d;
+        }
+    } else if (kinds[node] == PRODUCT) {
+        // the derivative by an argument is the product of the other arguments
+        for (int a = offsets[node]; a < offsets[node + 1]; a++) {
+            double value = values[args[a]];
+            if (zeros[node] == 0) {
+                derivatives[args[a]] += d * nonZero[node] / value;
+            } else if (zeros[node] == 1 && value == 0) {
+                derivatives[args[a]] += d * nonZero[node];
+            }
+        }
+    }
+}
+
+void ArithmeticCircuit::_scale(vector<double> &table, int begin, int end) {
+    double max = 0;
+    for (int i = begin; i < end; i++) {
+        max = std::max(max, table[i]);
+    }
+    if (max > 0) {
+        for (int i = begin; i < end; i++) {
+            table[i] /= max;
+        }
+    }
+}
+
+void ArithmeticCircuit::_evaluate() {
+    for (long v = 0; v < numOfNodes; v++) {
+        values[indicators[2 * v]] = 1;
+        values[indicators[2 * v + 1]] = 1;
+    }
+    for (long v = 0; v < numOfNodes; v++) {
+        if (evidences[v] >= 0) {
+            values[indicators[2 * v + 1 - evidences[v]]] = 0;
+        }
+    }
+    for (auto &block : blocks) {
+        for (int node = block.begin; node < block.end; node++) {
+            _evaluate(node);
+        }
+        _scale(values, block.sums, block.end);
+    }
+    _evaluate(output);
+}
+
+void ArithmeticCircuit::_differentiate() {
+    std::fill(derivatives.begin(), derivatives.end(), 0);
+    derivatives[output] = 1;
+    _differentiate(output);
+    for (auto block = blocks.rbegin(); block != blocks.rend(); block++) {
+        // every use of the messages of a block lies in a later block
+        _scale(derivatives, block->sums, block->end);
+        for (int node = block->end - 1; node >= block->begin; node--) {
+            _differentiate(node);
+        }
+    }
+}
+
+void ArithmeticCircuit::evidenceChanged(long /*node*/) {
+    stale = true;
+}
+
+double ArithmeticCircuit::getProbability(long node, long state) {
+    if (node < 0 || node >= numOfNodes) {
+        return 0;
+    }
+    if (evidences[node] >= 0) {
+        return evidences[node] == state ? 1 : 0;
+    }
+    if (stale) {
+        _evaluate();
+        _differentiate();
+        stale = false;
+    }
+    double p0 = derivatives[indicators[2 * node]];
+    double p1 = derivatives[indicators[2 * node + 1]];
+    if (p0 + p1 <= 0) {
+        return 0;
+    }
+    return (state ? p1 : p0) / (p0 + p1);
+}
+
+void ArithmeticCircuit::clearSolution() {
+    // the circuit is kept, the next query after an evidence change evaluates it again
+}
+
+long ArithmeticCircuit::numOfCircuitNodes() {
+    return kinds.size();
+}
+
+long ArithmeticCircuit::numOfCircuitEdges() {
+    return args.size();
+}
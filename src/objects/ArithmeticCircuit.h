@@ -0,0 +1,93 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_ARITHMETICCIRCUIT_H_
+#define OBJECTS_ARITHMETICCIRCUIT_H_
+
+#include <vector>
+#include "FactorizedCPT.h"
+#include "InferenceBackend.h"
+#include "JunctionTree.h"
+
+using namespace std;
+
+/*
+ * Inference backend on an arithmetic circuit, compiled once from the junction tree of
+ * the network. The circuit computes the network polynomial, i.e., the sum over all
+ * network states of the product of the CPT entries and the evidence indicators
+ * lambda(v, s), which are 0 for a state contradicting the evidence of v and 1 otherwise.
+ * One forward evaluation and one backward pass of partial derivatives give
+ * P(v = s, e) = df / dlambda(v, s) for every node at once, so the cost of a solution
+ * is linear in the circuit size, whatever the number of queries.
+ * Circuit nodes are stored flat and in topological order, with their arguments in CSR
+ * form. Every clique compiles to one block: a product per table entry of its CPT
+ * constant, its own node's indicator and the messages from its children, followed by
+ * a sum per entry of its message to the parent. The messages of a block are scaled to a
+ * maximum of 1, in both directions, so that large networks do not underflow.
+ */
+class ArithmeticCircuit: public InferenceBackend {
+private:
+    enum Kind {
+        CONSTANT, INDICATOR, SUM, PRODUCT
+    };
+    struct Block {
+        // circuit nodes [begin, sums) are the entry products, [sums, end) the message sums
+        int begin;
+        int sums;
+        int end;
+    };
+    vector<char> kinds;
+    vector<double> values;
+    // constant factor of a product node, i.e., its entry of the clique's CPT product
+    vector<double> coefficients;
+    // arguments of node i are args[offsets[i]] to args[offsets[i + 1] - 1]
+    vector<int> offsets;
+    vector<int> args;
+    vector<Block> blocks;
+    // product of the component roots, the last node of the circuit
+    int output;
+    // indicator nodes of <node, state> at 2 x node + state
+    vector<int> indicators;
+    // partial derivatives, and the product of the non-zero arguments and the number of zero
+    // arguments of every product node
+    vector<double> derivatives;
+    vector<double> nonZero;
+    vector<int> zeros;
+    // number of nodes in the network before decomposition
+    long numOfNodes;
+    // whether the evidences changed since the last evaluation
+    bool stale;
+
+    int _addNode(Kind kind, double coefficient, const vector<int> &arguments);
+    void _evaluate(int node);
+    void _differentiate(int node);
+    static void _scale(vector<double> &table, int begin, int end);
+    void _compile(const JunctionTree &jt);
+    void _evaluate();
+    void _differentiate();
+protected:
+    virtual void evidenceChanged(long node) override;
+public:
+    virtual void BuildNetwork(long node_count,
+            const std::vector<FactorizedCPT> &cpts) override;
+    virtual double getProbability(long node, long state) override;
+    virtual void clearSolution() override;
+    long numOfCircuitNodes();
+    long numOfCircuitEdges();
+    ArithmeticCircuit();
+    virtual ~ArithmeticCircuit();
+};
+
+#endif /* OBJECTS_ARITHMETICCIRCUIT_H_ */
@@ -13,156 +13,376 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include <algorithm>
+#include "../common/Logger.h"
 #include "BNInferenceEngine.h"
 
 BNInferenceEngine::BNInferenceEngine() {
-    // TODO Auto-generated constructor stub
-
+    backend = DLIB;
+    maxSamples = 10000;
+    timeBudget = 0;
+    rng = nullptr;
+    error = 0;
+    BNet = _createBackend();
+    subnet = NULL;
 }
 
 BNInferenceEngine::~BNInferenceEngine() {
-    // TODO Auto-generated destructor stub
+    delete BNet;
+    delete subnet;
+}
+
+InferenceBackend* BNInferenceEngine::_createBackend() {
+    if (backend == JUNCTION_TREE) {
+        return new JunctionTree();
+    } else if (backend == LIKELIHOOD_WEIGHTING) {
+        return new LikelihoodWeighting(maxSamples, timeBudget, rng);
+    } else if (backend == ARITHMETIC_CIRCUIT) {
+        return new ArithmeticCircuit();
+    }
+    return new BayesianNetwork();
+}
+
+void BNInferenceEngine::setBackend(Backend backend) {
+    this->backend = backend;
+    delete BNet;
+    BNet = _createBackend();
+    _resetSubnet();
+    cache.clear();
+    if (!cpts.empty()) {
+        BNet->BuildNetwork(cpts.size(), cpts);
+        // the new backend starts from the current evidences
+        for (size_t i = 0; i < evidence.size(); i++) {
+            if (evidence[i] >= 0) {
+                BNet->setEvidence(i, evidence[i]);
+            }
+        }
+    }
 }
 
-void BNInferenceEngine::loadModel(SituationGraph sg) {
+void BNInferenceEngine::setSamplingBudget(long maxSamples, double timeBudget) {
+    this->maxSamples = maxSamples;
+    this->timeBudget = timeBudget;
+}
+
+void BNInferenceEngine::setSamplingRNG(cRNG *rng) {
+    this->rng = rng;
+}
+
+double BNInferenceEngine::getErrorEstimate() {
+    return error;
+}
+
+void BNInferenceEngine::setCacheCapacity(size_t capacity) {
+    cache.setCapacity(capacity);
+}
+
+long BNInferenceEngine::numOfCacheHits() {
+    return cache.numOfHits();
+}
+
+long BNInferenceEngine::numOfCacheMisses() {
+    return cache.numOfMisses();
+}
+
+void BNInferenceEngine::loadModel(const SituationGraph &sg) {
     /*
      * Initialize Bayesian network
      */
-    // the informed graph size must be greater than any node index
-    long numOfNodes = (sg.modelHeight() + 1) * 100;
-    cout << "number_of_nodes: " << numOfNodes << endl;
-    std::set<pair<long, long>> edges;
-    for (auto relation : sg.relationMap) {
-        edges.insert(relation.first);
+    // BN nodes are the situation nodes only, numbered by SituationNode::index
+    long numOfNodes = sg.numOfNodes();
+    cpts.assign(numOfNodes, FactorizedCPT());
+    for (long i = 0; i < numOfNodes; i++) {
+        cpts[i].node = i;
     }
 
     /*
-     * Construct the CPT of the SG
+     * Construct the factorized CPT of the SG: each relation contributes a parent to
+     * its destination, i.e., a cause to its consequence and an evidence to its parent.
+     * Situations without any parent keep a uniform prior.
      */
-    std::map<std::tuple<long, long, std::set<std::pair<long, long>>>, double> CPT;
-    DirectedGraph g = sg.getLayer(0);
-    std::vector<long> sortedNodes = g.topo_sort();
-    for (auto node : sortedNodes) {
-
-//        cout << "set probability of node " << node << endl;
+    for (auto &relation : sg.relationMap) {
+        int src = sg.indexOf(relation.first.first);
+        int dest = sg.indexOf(relation.first.second);
+        if (src < 0 || dest < 0) {
+            continue;
+        }
+        cpts[dest].addParent(src, relation.second.weight,
+                relation.second.relation);
+    }
 
-        std::vector<long> &causes = sg.situationMap[node].causes;
-        if (causes.empty()) {
+    cache.clear();
+    _resetSubnet();
+    requisite.assign(numOfNodes, 0);
+    top.assign(numOfNodes, 0);
+    bottom.assign(numOfNodes, 0);
+    touched.clear();
+    local.assign(numOfNodes, -1);
+    children.assign(numOfNodes, std::vector<long>());
+    for (auto &cpt : cpts) {
+        for (auto parent : cpt.parents) {
+            children[parent].push_back(cpt.node);
+        }
+    }
 
-//            cout << "set priori probability of node " << node << endl;
+    BNet->BuildNetwork(numOfNodes, cpts);
+    evidence.assign(numOfNodes, -1);
+}
 
-            // Clear out parent state so that it doesn't have any of the previous assignment
-            std::tuple<long, long, std::set<std::pair<long, long>>> setting_0(node, 0, std::set<std::pair<long, long>>());
-            CPT[setting_0] = 0.5;
-            std::tuple<long, long, std::set<std::pair<long, long>>> setting_1(node, 1, std::set<std::pair<long, long>>());
-            CPT[setting_1] = 0.5;
+void BNInferenceEngine::subgraphExtraction(const std::vector<char> &evidence,
+        const std::vector<long> &queries, std::vector<long> &nodes) {
+    for (auto j : touched) {
+        requisite[j] = 0;
+        top[j] = 0;
+        bottom[j] = 0;
+    }
+    touched.clear();
 
-        } else {
-            const short size = causes.size();
-            // conditional probabilities of a single cause: p(B|A) = weight, p(B|-A) = 0
-            pair<double, double> p[size];
-            for (int i = 0; i < size; i++) {
-                SituationGraph::edge_id eid;
-                eid.first = causes[i];
-                eid.second = node;
-                SituationRelation sr = sg.relationMap[eid];
-                p[i].first = 0;
-                p[i].second = sr.weight;
+    /*
+     * The ball starts at every query as if it came from a child. An unobserved node
+     * passes a ball from a child to its parents and children, and one from a parent to its
+     * children only. An observed node bounces a ball from a parent back to its parents
+     * and blocks one from a child.
+     */
+    schedule.clear();
+    for (auto query : queries) {
+        schedule.push_back(std::make_pair(query, true));
+    }
+    while (!schedule.empty()) {
+        long j = schedule.back().first;
+        bool fromChild = schedule.back().second;
+        schedule.pop_back();
+        bool observed = evidence[j] >= 0;
+        if ((fromChild && !observed) || (!fromChild && observed)) {
+            if (!top[j]) {
+                if (!bottom[j]) {
+                    touched.push_back(j);
+                }
+                top[j] = 1;
+                for (auto parent : cpts[j].parents) {
+                    schedule.push_back(std::make_pair(parent, true));
+                }
             }
+        }
+        if (!observed && !bottom[j]) {
+            if (!top[j]) {
+                touched.push_back(j);
+            }
+            bottom[j] = 1;
+            for (auto child : children[j]) {
+                schedule.push_back(std::make_pair(child, false));
+            }
+        }
+    }
 
-            // 2^n binary combinations
-            const short totalCombinations = 1 << size;
-            for (int i = 0; i < totalCombinations; i++) {
-                std::set<std::pair<long, long>> parent_state;
-                // Be careful! It means the number of cause of a situation cannot exceed 32
-                bitset<32> binary(i);
-                // conditional probability of multiple causes
-                double p_cond = 1;
-                for (int i = 0; i < size; i++) {
-
-//                    cout << "causes[i]: " << causes[i] << endl;
-
-                    std::pair<long, long> parent;
-                    parent.first = causes[i];
-                    if (binary[i]) {
-                        p_cond *= p[i].second;
-                        parent.second = 1;
-                        parent_state.insert(parent);
-                    } else {
-                        p_cond *= p[i].first;
-                        parent.second = 0;
+    /*
+     * The CPT of every node marked on top is needed, and so are its parents, which are
+     * either marked on top as well or observed
+     */
+    size_t marked = touched.size();
+    for (size_t k = 0; k < marked; k++) {
+        long i = touched[k];
+        if (top[i]) {
+            requisite[i] = 2;
+            for (auto parent : cpts[i].parents) {
+                if (!requisite[parent]) {
+                    requisite[parent] = 1;
+                    if (!top[parent] && !bottom[parent]) {
+                        touched.push_back(parent);
                     }
-                    parent_state.insert(parent);
                 }
+            }
+        }
+    }
+    nodes.clear();
+    for (auto j : touched) {
+        if (requisite[j]) {
+            nodes.push_back(j);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+}
+
+InferenceBackend* BNInferenceEngine::_subnet(const std::vector<long> &nodes) {
+    bool same = subnet && nodes == subnetNodes;
+    for (size_t i = 0; same && i < nodes.size(); i++) {
+        same = requisite[nodes[i]] == subnetMarks[i];
+    }
+    if (same) {
+        return subnet;
+    }
 
-                std::tuple<long, long, std::set<std::pair<long, long>>> setting_0(node, 1, parent_state);
-                CPT[setting_0] = p_cond;
-                std::tuple<long, long, std::set<std::pair<long, long>>> setting_1(node, 0, parent_state);
-                CPT[setting_1] = 1 - p_cond;
-
-//                cout << "print CPT of node " << node << endl;
-//                cout << "condition: ";
-//                for(int i= 0; i < size; i++){
-//                  cout << binary[i] << ", ";
-//                }
-//                cout << endl;
-//                cout << "conditional probability of p(triggered): " << p_cond << endl;
-//                cout << "conditional probability of p(untriggered): " << 1- p_cond << endl;
+    /*
+     * Build the requisite subnetwork, whose nodes are renumbered densely. An observed
+     * parent whose CPT is not needed becomes a root, as its prior cancels out.
+     */
+    for (auto node : subnetNodes) {
+        local[node] = -1;
+    }
+    subnetNodes = nodes;
+    subnetMarks.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        local[nodes[i]] = i;
+        subnetMarks[i] = requisite[nodes[i]];
+    }
+    size_t maxParents = 0;
+    for (auto node : nodes) {
+        maxParents = std::max(maxParents, cpts[node].parents.size());
+    }
+    FactorizedCPT::resize(subCpts, nodes.size(), maxParents, spareCpts);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const FactorizedCPT &cpt = cpts[nodes[i]];
+        subCpts[i].clear();
+        subCpts[i].node = i;
+        if (requisite[nodes[i]] == 2) {
+            subCpts[i].prior = cpt.prior;
+            for (size_t k = 0; k < cpt.parents.size(); k++) {
+                subCpts[i].addParent(local[cpt.parents[k]], cpt.weights[k],
+                        cpt.relations[k]);
             }
         }
     }
+    if (!subnet) {
+        subnet = _createBackend();
+    }
+    subnet->BuildNetwork(nodes.size(), subCpts);
+    return subnet;
+}
 
-    BNet.BuildNetwork(numOfNodes, edges, CPT);
+void BNInferenceEngine::_resetSubnet() {
+    delete subnet;
+    subnet = NULL;
+    for (auto node : subnetNodes) {
+        local[node] = -1;
+    }
+    subnetNodes.clear();
+    subnetMarks.clear();
 }
 
-void BNInferenceEngine::reason(SituationGraph sg,
-        std::map<int, SituationInstance> &instanceMap, simtime_t current) {
+void BNInferenceEngine::_infer(const std::vector<char> &evidence,
+        const std::vector<long> &queries, std::vector<double> &probabilities) {
+    probabilities.clear();
+    std::vector<long> &nodes = requisiteNodes;
+    subgraphExtraction(evidence, queries, nodes);
 
     /*
-     * Build a Bayesian network solution
+     * The posteriors only depend on the queries and the evidence of requisite nodes,
+     * which is the signature of a refinement: <number of queries, queries...,
+     * 2 x node + state of each requisite evidence...>
      */
-    std::map<long, long> evidences;
-    for (auto instance : instanceMap) {
-        long sid = instance.first;
-        SituationInstance si = instance.second;
-        if (si.state == SituationInstance::TRIGGERING || si.state == SituationInstance::TRIGGERED) {
-            // TODO here, instance alignment is included, correct and fully implemented?
-            evidences[sid] = 1;
+    signature.clear();
+    if (cache.isEnabled()) {
+        signature.push_back(queries.size());
+        signature.insert(signature.end(), queries.begin(), queries.end());
+        for (auto node : nodes) {
+            if (evidence[node] >= 0) {
+                signature.push_back(2 * node + evidence[node]);
+            }
+        }
+        if (cache.lookup(signature, probabilities, error)) {
+            return;
+        }
+    }
 
-            cout << "set evidence of node " << sid << ": " << 1 << endl;
-        }else if(si.state == SituationInstance::UNTRIGGERED){
-            evidences[sid] = 0;
+    /*
+     * A large subnetwork is cheaper to answer on the whole network, whose backend
+     * propagates evidence changes incrementally
+     */
+    if (nodes.size() * 2 > cpts.size()) {
+        for (auto query : queries) {
+            probabilities.push_back(BNet->getProbability(query, 1));
+        }
+        error = BNet->getErrorEstimate();
+        cache.insert(signature, probabilities, error);
+        return;
+    }
 
-            cout << "set evidence of node " << sid << ": " << 0 << endl;
+    /*
+     * Refine on the requisite subnetwork, whose backend keeps the evidences of its
+     * last refinement
+     */
+    InferenceBackend *net = _subnet(nodes);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (evidence[nodes[i]] >= 0) {
+            net->setEvidence(i, evidence[nodes[i]]);
+        } else {
+            net->retractEvidence(i);
         }
     }
-    BNet.buildSolution(evidences);
+    for (auto query : queries) {
+        probabilities.push_back(net->getProbability(local[query], 1));
+    }
+    error = net->getErrorEstimate();
+    cache.insert(signature, probabilities, error);
+}
+
+void BNInferenceEngine::reason(const SituationGraph &sg,
+        std::vector<SituationInstance> &instances,
+        const std::vector<int> &changed, const std::vector<int> &undetermined,
+        simtime_t current) {
 
     /*
-     * Bayesian network-based state inference
+     * Update the Bayesian network solution
+     * The backend keeps the evidences of the previous reasoning, so only the situations
+     * whose state changed are visited, and only actual evidence changes are propagated.
      */
-    for (auto& instance : instanceMap) {
-        long sid = instance.first;
-        SituationInstance &si = instance.second;
-        // probability of triggering
-        double p_tr = BNet.getProbability(sid, 1);
-        if(si.state == SituationInstance::UNDETERMINED){
-            if (p_tr >= sg.situationMap[sid].threshold) {
-                si.state = SituationInstance::TRIGGERING;
-                si.counter++;
-                si.next_start = current;
-            } else {
-                si.state = SituationInstance::UNTRIGGERED;
-            }
+    for (auto i : changed) {
+        SituationInstance &si = instances[i];
+        char state = -1;
+        if (si.state == SituationInstance::TRIGGERING || si.state == SituationInstance::TRIGGERED) {
+            // TODO here, instance alignment is included, correct and fully implemented?
+            state = 1;
+        } else if (si.state == SituationInstance::UNTRIGGERED) {
+            state = 0;
+        }
+        if (state == evidence[i]) {
+            continue;
+        }
+        evidence[i] = state;
+        if (state >= 0) {
+            BNet->setEvidence(i, state);
+
+            LOG_TRACE("set evidence of node " << si.id << ": " << (int) state);
+        } else {
+            BNet->retractEvidence(i);
+        }
+    }
 
-                cout << "probability of triggering node " << sid << ": " << p_tr << endl;
-                cout << "state of undetermined node " << sid << ": " << si.state << endl;
-                cout << "counter of node " << sid << ": " << si.counter << endl;
+    // every undetermined situation is queried once, in index order
+    queries.clear();
+    for (auto i : undetermined) {
+        if (instances[i].state == SituationInstance::UNDETERMINED) {
+            queries.push_back(i);
         }
     }
+    std::sort(queries.begin(), queries.end());
+    queries.erase(std::unique(queries.begin(), queries.end()), queries.end());
+    error = 0;
+    if (queries.empty()) {
+        return;
+    }
 
     /*
-     * Clear the solution
+     * Bayesian network-based state inference of the undetermined situations only,
+     * on the subnetwork relevant to them
      */
-    BNet.clearSolution();
+    _infer(evidence, queries, probabilities);
+    for (size_t k = 0; k < queries.size(); k++) {
+        long i = queries[k];
+        SituationInstance &si = instances[i];
+        long sid = si.id;
+        // probability of triggering
+        double p_tr = probabilities[k];
+        if (p_tr >= sg.nodes[i].threshold) {
+            si.state = SituationInstance::TRIGGERING;
+            si.counter++;
+            si.next_start = current;
+        } else {
+            si.state = SituationInstance::UNTRIGGERED;
+        }
+
+        LOG_TRACE("probability of triggering node " << sid << ": " << p_tr);
+        LOG_TRACE("state of undetermined node " << sid << ": " << si.state);
+        LOG_TRACE("counter of node " << sid << ": " << si.counter);
+    }
 }
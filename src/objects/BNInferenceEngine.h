@@ -19,28 +19,117 @@
 #include <map>
 #include <set>
 #include <vector>
-#include <tuple>
 #include <utility>
-#include <bitset>
 #include <omnetpp.h>
 #include "SituationInstance.h"
 #include "SituationGraph.h"
 #include "DirectedGraph.h"
+#include "FactorizedCPT.h"
+#include "InferenceBackend.h"
 #include "BayesianNetwork.h"
+#include "JunctionTree.h"
+#include "ArithmeticCircuit.h"
+#include "LikelihoodWeighting.h"
+#include "PosteriorCache.h"
 
 using namespace std;
 using namespace omnetpp;
 
 class BNInferenceEngine {
+public:
+    enum Backend {
+        DLIB, JUNCTION_TREE, LIKELIHOOD_WEIGHTING, ARITHMETIC_CIRCUIT
+    };
 private:
-    BayesianNetwork BNet;
+    Backend backend;
+    // owned, on the whole network
+    InferenceBackend *BNet;
+    // factorized CPT of each situation, indexed by SituationNode::index
+    std::vector<FactorizedCPT> cpts;
+    // children of each situation in the network
+    std::vector<std::vector<long>> children;
+    // budget of LIKELIHOOD_WEIGHTING per reasoning: number of samples and wall-clock
+    // seconds, 0 for no time budget
+    long maxSamples;
+    double timeBudget;
+    // RNG of LIKELIHOOD_WEIGHTING, not owned
+    cRNG *rng;
+    double error;
+    // posteriors of recurring refinements, keyed by the queries and the pruned evidence
+    PosteriorCache cache;
+    // evidence of each node in the backend: its state, or -1 if not observed
+    std::vector<char> evidence;
+    /*
+     * Scratch buffers reused by every reasoning, so that a refinement answered on the
+     * whole network or from the cache does not allocate
+     */
+    std::vector<long> queries;
+    std::vector<double> probabilities;
+    std::vector<long> requisiteNodes;
+    std::vector<long> signature;
+    /*
+     * Bayes-ball marks of every node and schedule: <node, whether the ball comes from a
+     * child>. Only the nodes marked by the last extraction, listed in touched, are
+     * cleared by the next one, so an extraction costs the size of the subnetwork.
+     */
+    std::vector<char> requisite;
+    std::vector<char> top;
+    std::vector<char> bottom;
+    std::vector<long> touched;
+    std::vector<std::pair<long, bool>> schedule;
+    /*
+     * Backend of the last requisite subnetwork, owned. It is reused as long as the
+     * requisite nodes and their marks stay the same, and rebuilt in place otherwise.
+     */
+    InferenceBackend *subnet;
+    std::vector<long> subnetNodes;
+    std::vector<char> subnetMarks;
+    std::vector<FactorizedCPT> subCpts;
+    // CPTs of a larger subnetwork built before, whose buffers are reused
+    std::vector<FactorizedCPT> spareCpts;
+    // index of every node in the subnetwork, -1 outside of it
+    std::vector<long> local;
 //    void constructCPT();
-//    void subgraphExtraction();
+    InferenceBackend* _createBackend();
+    /*
+     * Requisite nodes to answer P(queries | evidence) by Bayes-ball (Shachter, 1998),
+     * where evidence[i] is the state of node i or -1, in ascending order. Nodes whose CPT
+     * is needed are marked in requisite with 2, observed parents whose CPT is not needed
+     * with 1.
+     */
+    void subgraphExtraction(const std::vector<char> &evidence,
+            const std::vector<long> &queries, std::vector<long> &nodes);
+    // the subnetwork backend on the requisite nodes of the last extraction
+    InferenceBackend* _subnet(const std::vector<long> &nodes);
+    void _resetSubnet();
+    // P(query = 1 | evidence) of every query, on the requisite subnetwork if it is small
+    void _infer(const std::vector<char> &evidence,
+            const std::vector<long> &queries, std::vector<double> &probabilities);
 public:
-    void loadModel(SituationGraph sg);
-    void reason(SituationGraph sg,
-            std::map<int, SituationInstance> &instanceMap, simtime_t current);
+    // switch the inference backend, rebuilding the network if a model is loaded
+    void setBackend(Backend backend);
+    // effective for LIKELIHOOD_WEIGHTING backends created afterwards
+    void setSamplingBudget(long maxSamples, double timeBudget);
+    void setSamplingRNG(cRNG *rng);
+    // error estimate of the last reasoning
+    double getErrorEstimate();
+    // maximum number of cached refinements, 0 to disable the cache
+    void setCacheCapacity(size_t capacity);
+    long numOfCacheHits();
+    long numOfCacheMisses();
+    void loadModel(const SituationGraph &sg);
+    /*
+     * Refine the UNDETERMINED instances among undetermined. Instances are indexed by
+     * SituationNode::index, and only the ones in changed may have changed their state
+     * since the last reasoning, so only their evidences are updated.
+     */
+    void reason(const SituationGraph &sg,
+            std::vector<SituationInstance> &instances,
+            const std::vector<int> &changed, const std::vector<int> &undetermined,
+            simtime_t current);
     BNInferenceEngine();
+    BNInferenceEngine(const BNInferenceEngine&) = delete;
+    BNInferenceEngine& operator=(const BNInferenceEngine&) = delete;
     virtual ~BNInferenceEngine();
 };
 
@@ -13,6 +13,7 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include "../common/Logger.h"
 #include "BayesianNetwork.h"
 
 BayesianNetwork::BayesianNetwork() {
@@ -26,71 +27,86 @@ BayesianNetwork::~BayesianNetwork() {
 }
 
 void BayesianNetwork::BuildNetwork(long node_count,
-        std::set<std::pair<long, long>> edges,
-        std::map<std::tuple<long, long, std::set<std::pair<long, long>>>, double> CPT) {
-    std::set<long> nodes;
+        const std::vector<FactorizedCPT> &cpts) {
+    // drop any network built before
+    clearSolution();
+    evidences.assign(node_count, -1);
+    BNet.clear();
+
     /*
-     * Initialize Bayesian network
+     * Initialize Bayesian network, including auxiliary nodes of decomposed CPTs
      */
-    cout << "number_of_nodes: " << node_count << endl;
-    BNet.set_number_of_nodes(node_count);
-    for (auto edge : edges) {
-        long src = edge.first;
-        long dest = edge.second;
-        nodes.insert(src);
-        nodes.insert(dest);
-        BNet.add_edge(src, dest);
-    }
+    std::vector<FactorizedCPT> network = FactorizedCPT::decompose(cpts,
+            FactorizedCPT::MAX_TABLE_PARENTS);
+    long total = network.size();
+    LOG_DEBUG("number_of_nodes: " << total);
+    BNet.set_number_of_nodes(total);
     /*
      * Inform all the nodes in the network that they are binary.
      * That is, they only have two possible values.
      */
-    for (auto node : nodes) {
+    for (long node = 0; node < total; node++) {
         set_node_num_values(BNet, node, 2);
     }
 
     /*
      * Construct the CPT of the SG
      */
-    assignment parent_state;
-    for (auto entry : CPT) {
-        // child node ID
-        long c_id = std::get<0>(entry.first);
-        // child node state
-        long c_state = std::get<1>(entry.first);
-        double p = entry.second;
-        std::set<std::pair<long, long>> causes = std::get<2>(entry.first);
-        if (causes.size() > 0) {
-            for (auto cause : causes) {
-                long id = cause.first;
-                long p_state = cause.second;
-                parent_state.add(id, p_state);
-            }
-        }
-        set_node_probability(BNet, c_id, c_state, parent_state, p);
-        // Clear out parent state so that it doesn't have any of the previous assignment
-        parent_state.clear();
+    for (auto &cpt : network) {
+        _setTable(cpt);
     }
-}
 
-void BayesianNetwork::buildSolution(std::map<long, long> evidences) {
-    typedef dlib::set<unsigned long>::compare_1b_c set_type;
-    typedef graph<set_type, set_type>::kernel_1a_c join_tree_type;
-    join_tree_type join_tree;
+    /*
+     * Build the join tree once for all solutions, from scratch if a network was built
+     * before
+     */
+    join_tree.clear();
     create_moral_graph(BNet, join_tree);
     create_join_tree(join_tree, join_tree);
+}
 
-    for (auto evidence : evidences) {
-        long id = evidence.first;
-        long state = evidence.second;
-        set_node_value(BNet, id, state);
-        set_node_as_evidence(BNet, id);
+/*
+ * Set p(node = 1 | parents) and p(node = 0 | parents), where bit i of parentStates is the state of parents[i]
+ */
+void BayesianNetwork::_setNodeProbability(long node,
+        const std::vector<long> &parents, unsigned long parentStates, double p) {
+    assignment parent_state;
+    for (size_t i = 0; i < parents.size(); i++) {
+        parent_state.add(parents[i], (parentStates >> i) & 1);
     }
+    set_node_probability(BNet, node, 1, parent_state, p);
+    set_node_probability(BNet, node, 0, parent_state, 1 - p);
+}
+
+void BayesianNetwork::_setTable(const FactorizedCPT &cpt) {
+    for (auto parent : cpt.parents) {
+        BNet.add_edge(parent, cpt.node);
+    }
+    // 2^n binary combinations, n <= FactorizedCPT::MAX_TABLE_PARENTS
+    unsigned long totalCombinations = 1UL << cpt.parents.size();
+    for (unsigned long states = 0; states < totalCombinations; states++) {
+        double p = cpt.probability([states](int i) {
+            return (states >> i) & 1;
+        });
+        _setNodeProbability(cpt.node, cpt.parents, states, p);
+    }
+}
 
-    solution_with_evidence = new bayesian_network_join_tree(BNet, join_tree);
+void BayesianNetwork::evidenceChanged(long node) {
+    if (evidences[node] >= 0) {
+        set_node_value(BNet, node, evidences[node]);
+        set_node_as_evidence(BNet, node);
+    } else {
+        set_node_as_nonevidence(BNet, node);
+    }
+    clearSolution();
 }
 
 double BayesianNetwork::getProbability(long node, long state) {
+    // dlib propagates over the whole join tree, so an unchanged solution is kept
+    if (!solution_with_evidence) {
+        solution_with_evidence = new bayesian_network_join_tree(BNet, join_tree);
+    }
     return solution_with_evidence->probability(node)(state);
 }
 
@@ -99,5 +115,4 @@ void BayesianNetwork::clearSolution() {
         delete solution_with_evidence;
         solution_with_evidence = NULL;
     }
-    BNet.clear();
 }
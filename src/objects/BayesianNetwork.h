@@ -18,35 +18,51 @@
 
 #include <set>
 #include <map>
-#include <tuple>
+#include <vector>
 #include <dlib/bayes_utils.h>
 #include <dlib/graph_utils.h>
 #include <dlib/graph.h>
 #include <dlib/directed_graph.h>
+#include "FactorizedCPT.h"
+#include "InferenceBackend.h"
 
 using namespace std;
 using namespace dlib;
 using namespace bayes_node_utils;
 
-class BayesianNetwork {
+/*
+ * Inference backend on dlib's bayesian_network_join_tree
+ */
+class BayesianNetwork: public InferenceBackend {
 private:
+    typedef dlib::set<unsigned long>::compare_1b_c set_type;
+    typedef graph<set_type, set_type>::kernel_1a_c join_tree_type;
+
     bayesian_network_join_tree* solution_with_evidence;
     directed_graph<bayes_node>::kernel_1a_c BNet;
+    // the network structure is fixed once built, so its join tree is built only once
+    join_tree_type join_tree;
+
+    void _setNodeProbability(long node, const std::vector<long> &parents,
+            unsigned long parentStates, double p);
+    void _setTable(const FactorizedCPT &cpt);
+protected:
+    // the evidence is updated in BNet at once, the solution is rebuilt on the next query
+    virtual void evidenceChanged(long node) override;
 public:
     /*
-     * 1. edges contains a <src, dest> pairs of nodes.
-     * 2. They key of each entry in CPT is a tuple<child, c_state, set<parent, p_state>>,
-     * an empty set for a leaf node; The value of the entry is the conditional probability.
-     */
-    void BuildNetwork(long node_count, std::set<std::pair<long, long>> edges,
-            std::map<std::tuple<long, long, std::set<std::pair<long, long>>>,
-                    double> CPT);
-    /*
-     * An evidence is in the format of <node ID, state>, where state is either 0 or 1.
+     * Nodes are numbered densely from 0 to node_count - 1, and every node is binary.
+     * cpts contains one factorized CPT per node, whose parents define the network edges.
+     * A CPT with up to FactorizedCPT::MAX_TABLE_PARENTS parents is tabulated directly.
+     * A larger one is decomposed exactly into chains of auxiliary nodes numbered after
+     * node_count (see FactorizedCPT::decompose), so the network stays linear in the
+     * number of parents.
      */
-    void buildSolution(std::map<long, long> evidences);
-    double getProbability(long node, long state);
-    void clearSolution();
+    virtual void BuildNetwork(long node_count,
+            const std::vector<FactorizedCPT> &cpts) override;
+    virtual double getProbability(long node, long state) override;
+    // release the current solution, the network and its join tree are kept for the next solution
+    virtual void clearSolution() override;
     BayesianNetwork();
     virtual ~BayesianNetwork();
 };
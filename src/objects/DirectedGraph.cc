@@ -14,30 +14,125 @@
 // 
 
 #include <iostream>
-#include <algorithm>
+#include "../common/Logger.h"
 #include "DirectedGraph.h"
 
 DirectedGraph::DirectedGraph() {
-    // TODO Auto-generated constructor stub
+    finalized = false;
+    sorted = false;
 }
 
 void DirectedGraph::add_vertex(long vertex) {
+    if (finalized) {
+        _thaw();
+    }
     verList.insert(vertex);
+    sorted = false;
 }
 
 // Function to add an edge from vertices u to v of the graph
 void DirectedGraph::add_edge(long src, long dest) {
+    if (finalized) {
+        _thaw();
+    }
     // Add edge from u to v
     adjList[src].push_back(dest);
+    sorted = false;
+}
+
+void DirectedGraph::finalize() {
+    if (finalized) {
+        return;
+    }
+
+    /*
+     * 1. Renumber vertices densely in ascending ID order
+     */
+    set<long> ids(verList);
+    for (auto &adj : adjList) {
+        ids.insert(adj.first);
+        ids.insert(adj.second.begin(), adj.second.end());
+    }
+    vertexIds.assign(ids.begin(), ids.end());
+    vertexIndex.clear();
+    vertexIndex.reserve(vertexIds.size());
+    for (size_t i = 0; i < vertexIds.size(); i++) {
+        vertexIndex[vertexIds[i]] = i;
+    }
+
+    /*
+     * 2. Pack successor lists
+     */
+    int n = vertexIds.size();
+    offsets.assign(n + 1, 0);
+    for (auto &adj : adjList) {
+        offsets[vertexIndex[adj.first] + 1] = adj.second.size();
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    targets.resize(offsets[n]);
+    for (auto &adj : adjList) {
+        int e = offsets[vertexIndex[adj.first]];
+        for (auto dest : adj.second) {
+            targets[e++] = vertexIndex[dest];
+        }
+    }
+
+    adjList.clear();
+    verList.clear();
+    finalized = true;
+}
+
+void DirectedGraph::_thaw() {
+    for (int i = 0; i < num_vertices(); i++) {
+        verList.insert(vertexIds[i]);
+        for (auto j : successors(i)) {
+            adjList[vertexIds[i]].push_back(vertexIds[j]);
+        }
+    }
+    vertexIds.clear();
+    vertexIndex.clear();
+    offsets.clear();
+    targets.clear();
+    finalized = false;
+}
+
+bool DirectedGraph::isFinalized() const {
+    return finalized;
+}
+
+int DirectedGraph::num_vertices() const {
+    return vertexIds.size();
+}
+
+long DirectedGraph::vertex(int index) const {
+    return vertexIds[index];
+}
+
+int DirectedGraph::index_of(long vertex) const {
+    auto it = vertexIndex.find(vertex);
+    if (it == vertexIndex.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+DirectedGraph::Successors DirectedGraph::successors(int index) const {
+    const int *base = targets.data();
+    return Successors(base + offsets[index], base + offsets[index + 1]);
 }
 
 void DirectedGraph::DFS_topological(unordered_map<long, bool> &visited, stack<long> &st,
-        long node) {
+        long node) const {
     visited[node] = true;
 
-    for (auto neighbor : adjList[node]) {
-        if (!visited[neighbor]) {
-            DFS_topological(visited, st, neighbor);
+    auto adj = adjList.find(node);
+    if (adj != adjList.end()) {
+        for (auto neighbor : adj->second) {
+            if (!visited[neighbor]) {
+                DFS_topological(visited, st, neighbor);
+            }
         }
     }
     //Pushing a node after all its connected elements are traversed.
@@ -47,59 +142,151 @@ void DirectedGraph::DFS_topological(unordered_map<long, bool> &visited, stack<lo
     return;
 }
 
-vector<long> DirectedGraph::topo_sort() {
+void DirectedGraph::_sort() const {
+    if (finalized) {
+        _sortFinalized();
+        return;
+    }
+
     unordered_map<long, bool> visited;
     stack<long> st;
 
-    int V = adjList.size();
-    for (auto adj : adjList) {
+    for (auto &adj : adjList) {
         long key = adj.first;
         if (!visited[key]) {
             DFS_topological(visited, st, key);
         }
     }
 
-    vector<long> ans;
+    topoOrder.clear();
+    topoOrder.reserve(verList.size() + st.size());
+
+    // add orphan vertices at the beginning of the vector to return
+    for (auto vertex : verList) {
+        if (!visited.count(vertex)) {
+            topoOrder.push_back(vertex);
+        }
+    }
+
     while (!st.empty()) {
-        ans.push_back(st.top());
+        topoOrder.push_back(st.top());
         st.pop();
     }
 
+    reverseTopoOrder.assign(topoOrder.rbegin(), topoOrder.rend());
+    sorted = true;
+}
+
+/*
+ * The same DFS as _sort() over the CSR arrays, made iterative:
+ * roots are vertices with successors in ascending ID order and successors are
+ * visited in insertion order, so both forms yield the same order.
+ */
+void DirectedGraph::_sortFinalized() const {
+    int n = num_vertices();
+    vector<char> visited(n, 0);
+    vector<int> postOrder;
+    postOrder.reserve(n);
+    // DFS frames of <vertex, next edge>
+    vector<pair<int, int>> frames;
+
+    for (int root = 0; root < n; root++) {
+        if (visited[root] || offsets[root] == offsets[root + 1]) {
+            continue;
+        }
+        visited[root] = 1;
+        frames.push_back(make_pair(root, offsets[root]));
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            int e = frames.back().second;
+            if (e < offsets[v + 1]) {
+                frames.back().second++;
+                int w = targets[e];
+                if (!visited[w]) {
+                    visited[w] = 1;
+                    frames.push_back(make_pair(w, offsets[w]));
+                }
+                continue;
+            }
+            frames.pop_back();
+            if (vertexIds[v] != -1) {
+                postOrder.push_back(v);
+            }
+        }
+    }
+
+    topoOrder.clear();
+    topoOrder.reserve(n);
+
     // add orphan vertices at the beginning of the vector to return
-    int i = 0;
-    for (auto vertex : verList) {
-        if (find(ans.begin(), ans.end(), vertex) == ans.end()) {
-            ans.insert(ans.begin() + i, vertex);
-            i++;
+    for (int i = 0; i < n; i++) {
+        if (!visited[i]) {
+            topoOrder.push_back(vertexIds[i]);
         }
     }
+    for (auto it = postOrder.rbegin(); it != postOrder.rend(); ++it) {
+        topoOrder.push_back(vertexIds[*it]);
+    }
+
+    reverseTopoOrder.assign(topoOrder.rbegin(), topoOrder.rend());
+    sorted = true;
+}
+
+const vector<long>& DirectedGraph::topo_sort() const {
+    if (!sorted) {
+        _sort();
+    }
+    return topoOrder;
+}
 
-    return ans;
+const vector<long>& DirectedGraph::reverse_topo_sort() const {
+    if (!sorted) {
+        _sort();
+    }
+    return reverseTopoOrder;
 }
 
 // Function to print the adjacency list representation of the graph
 void DirectedGraph::print() {
+    // written as one log record, so that the list is not interleaved with other records
+    Logger::Record record;
+    std::ostream &os = record.stream();
+    if (finalized) {
+        os << "Adjacency list for the Graph: " << endl;
+        for (int i = 0; i < num_vertices(); i++) {
+            os << vertexIds[i];
+            if (successors(i).size() > 0) {
+                os << " -> ";
+                for (auto j : successors(i)) {
+                    os << vertexIds[j] << " ";
+                }
+            }
+            os << endl;
+        }
+        return;
+    }
+
     set<long> printed;
-    cout << "Adjacency list for the Graph: " << endl;
+    os << "Adjacency list for the Graph: " << endl;
     // Iterate over each vertex
     for (auto i : adjList) {
         // Print the vertex
-        cout << i.first << " -> ";
+        os << i.first << " -> ";
         printed.insert((long) i.first);
         // Iterate over the connected vertices
         for (auto j : i.second) {
             // Print the connected vertex
-            cout << j << " ";
+            os << j << " ";
             printed.insert((long) j);
         }
-        cout << endl;
+        os << endl;
     }
 
     // print orphan vertices
     for (auto vertex : verList) {
         auto it = printed.find(vertex);
         if (it == printed.end()) {
-            cout << vertex << endl;
+            os << vertex << endl;
         }
     }
 }
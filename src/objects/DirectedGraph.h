@@ -26,21 +26,74 @@
 using namespace std;
 
 class DirectedGraph {
+    // restores the frozen form from a precompiled model image
+    friend class ModelImage;
+public:
+    // a lightweight range over the successor indices of a vertex in the frozen form
+    class Successors {
+    private:
+        const int *first;
+        const int *last;
+    public:
+        Successors(const int *first, const int *last) :
+                first(first), last(last) {
+        }
+        const int* begin() const {
+            return first;
+        }
+        const int* end() const {
+            return last;
+        }
+        int size() const {
+            return last - first;
+        }
+    };
 private:
     map<long, list<long> > adjList; // Adjacency list to store the graph
     set<long> verList;
+    /*
+     * Frozen compressed sparse row (CSR) form built by finalize(): vertices are
+     * renumbered densely in ascending ID order, and the successors of vertex i are
+     * targets[offsets[i]] .. targets[offsets[i + 1] - 1], in insertion order.
+     */
+    bool finalized;
+    vector<long> vertexIds;
+    unordered_map<long, int> vertexIndex;
+    vector<int> offsets;
+    vector<int> targets;
+    // cached topological orders, valid until the graph is mutated
+    mutable vector<long> topoOrder;
+    mutable vector<long> reverseTopoOrder;
+    mutable bool sorted;
 
-    void DFS_topological(unordered_map<long, bool> &visited, stack<long> &st, long node);
+    void DFS_topological(unordered_map<long, bool> &visited, stack<long> &st, long node) const;
+    void _sort() const;
+    void _sortFinalized() const;
+    void _thaw();
 
 public:
     DirectedGraph();
     void add_vertex(long vertex);
     // Function to add an edge between vertices u and v of the graph
     void add_edge(long src, long dist);
+    /*
+     * Freeze the graph into its CSR form and release the adjacency list.
+     * A later add_vertex or add_edge turns the graph back into its mutable form.
+     */
+    void finalize();
+    bool isFinalized() const;
+    // CSR iteration, valid only on a finalized graph
+    int num_vertices() const;
+    long vertex(int index) const;
+    // return the dense index of a vertex, or -1 if the vertex is not in the graph
+    int index_of(long vertex) const;
+    Successors successors(int index) const;
     // Function to print the adjacency list representation of the graph
     void print();
     //Function to return list containing vertices in Topological order.
-    vector<long> topo_sort();
+    const vector<long>& topo_sort() const;
+    //Function to return list containing vertices in reverse Topological order.
+    const vector<long>& reverse_topo_sort() const;
     virtual ~DirectedGraph();
 };
 
@@ -0,0 +1,104 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "FactorizedCPT.h"
+
+FactorizedCPT::FactorizedCPT() {
+    node = -1;
+    prior = 0.5;
+}
+
+void FactorizedCPT::addParent(long parent, double weight,
+        SituationRelation::Relation relation) {
+    parents.push_back(parent);
+    weights.push_back(weight);
+    relations.push_back(relation);
+}
+
+void FactorizedCPT::clear() {
+    node = -1;
+    prior = 0.5;
+    parents.clear();
+    weights.clear();
+    relations.clear();
+}
+
+bool FactorizedCPT::isRoot() const {
+    return parents.empty();
+}
+
+bool FactorizedCPT::isOr(int i) const {
+    return relations[i] == SituationRelation::OR;
+}
+
+vector<FactorizedCPT> FactorizedCPT::decompose(
+        const vector<FactorizedCPT> &cpts, size_t maxParents) {
+    vector<FactorizedCPT> result(cpts);
+    for (size_t n = 0; n < cpts.size(); n++) {
+        const FactorizedCPT &cpt = cpts[n];
+        if (cpt.parents.size() <= maxParents) {
+            continue;
+        }
+
+        FactorizedCPT conjunction;
+        conjunction.node = cpt.node;
+        for (int group = 0; group < 2; group++) {
+            bool orGroup = group == 1;
+            SituationRelation::Relation relation =
+                    orGroup ? SituationRelation::OR : SituationRelation::AND;
+            long prev = -1;
+            for (size_t i = 0; i < cpt.parents.size(); i++) {
+                if (cpt.isOr(i) != orGroup) {
+                    continue;
+                }
+                FactorizedCPT link;
+                link.node = result.size();
+                if (prev >= 0) {
+                    link.addParent(prev, 1, relation);
+                }
+                link.addParent(cpt.parents[i], cpt.weights[i], relation);
+                prev = link.node;
+                result.push_back(link);
+            }
+            if (prev >= 0) {
+                conjunction.addParent(prev, 1, SituationRelation::AND);
+            }
+        }
+        result[n] = conjunction;
+    }
+    return result;
+}
+
+void FactorizedCPT::resize(vector<FactorizedCPT> &cpts, size_t count,
+        size_t maxParents, vector<FactorizedCPT> &spare) {
+    while (cpts.size() > count) {
+        spare.push_back(std::move(cpts.back()));
+        cpts.pop_back();
+    }
+    while (cpts.size() < count && !spare.empty()) {
+        cpts.push_back(std::move(spare.back()));
+        spare.pop_back();
+    }
+    cpts.resize(count);
+    for (auto &cpt : cpts) {
+        cpt.parents.reserve(maxParents);
+        cpt.weights.reserve(maxParents);
+        cpt.relations.reserve(maxParents);
+    }
+}
+
+FactorizedCPT::~FactorizedCPT() {
+    // TODO Auto-generated destructor stub
+}
@@ -0,0 +1,105 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_FACTORIZEDCPT_H_
+#define OBJECTS_FACTORIZEDCPT_H_
+
+#include <vector>
+#include "SituationRelation.h"
+
+using namespace std;
+
+/*
+ * Conditional probability of a binary Bayesian network node, kept in factorized form
+ * instead of a 2^n table over its parents:
+ * 1) SOLE and AND parents form a noisy-AND: every one of them must be triggered,
+ * each succeeding with its weight, i.e., prod_i (p_i ? w_i : 0);
+ * 2) OR parents form a noisy-OR: any of them may trigger the node with its weight,
+ * i.e., 1 - prod_i (p_i ? 1 - w_i : 1);
+ * 3) the node is triggered with the product of both terms, an absent group counting as 1.
+ * A node without parents is triggered with its prior.
+ */
+class FactorizedCPT {
+public:
+    // CPTs with more parents than this are decomposed by inference backends instead of tabulated
+    static const size_t MAX_TABLE_PARENTS = 4;
+    // BN node index
+    long node;
+    double prior;
+    vector<long> parents;
+    vector<double> weights;
+    vector<SituationRelation::Relation> relations;
+public:
+    FactorizedCPT();
+    FactorizedCPT(const FactorizedCPT&) = default;
+    FactorizedCPT(FactorizedCPT&&) = default;
+    FactorizedCPT& operator=(const FactorizedCPT&) = default;
+    FactorizedCPT& operator=(FactorizedCPT&&) = default;
+    // reset to a root with the default prior, keeping the buffers of the parents
+    void clear();
+    void addParent(long parent, double weight, SituationRelation::Relation relation);
+    bool isRoot() const;
+    bool isOr(int i) const;
+    /*
+     * P(node = 1 | parents), where stateOf(i) returns the state (0 or 1) of parents[i].
+     * The cost is linear in the number of parents.
+     */
+    template<typename StateOf>
+    double probability(StateOf stateOf) const {
+        if (parents.empty()) {
+            return prior;
+        }
+        double pAnd = 1;
+        double pNotOr = 1;
+        bool hasOr = false;
+        for (size_t i = 0; i < parents.size(); i++) {
+            bool triggered = stateOf(i);
+            if (isOr(i)) {
+                hasOr = true;
+                if (triggered) {
+                    pNotOr *= 1 - weights[i];
+                }
+            } else if (triggered) {
+                pAnd *= weights[i];
+            } else {
+                return 0;
+            }
+        }
+        return hasOr ? pAnd * (1 - pNotOr) : pAnd;
+    }
+    /*
+     * Decompose every CPT with more than maxParents parents exactly into chains of
+     * auxiliary nodes (parent divorcing). Chain node a_i has parents a_(i-1) and the i-th
+     * parent x_i of a group, so that
+     * 1) in the noisy-AND chain, p(a_i = 1) = a_(i-1) && x_i ? w_i : 0, and
+     * 2) in the noisy-OR chain, p(a_i = 1) = a_(i-1) ? 1 : (x_i ? w_i : 0),
+     * and the decomposed node becomes the conjunction of the chain ends. Every resulting CPT
+     * is again a FactorizedCPT with at most max(maxParents, 2) parents.
+     * cpts[i] must describe node i; auxiliary nodes are numbered from cpts.size().
+     */
+    static vector<FactorizedCPT> decompose(const vector<FactorizedCPT> &cpts,
+            size_t maxParents);
+    /*
+     * Resize cpts to count CPTs with room for maxParents parents each, where the CPTs
+     * dropped are moved to spare and taken back first when cpts grows again, so that
+     * networks rebuilt with varying sizes reuse the parent buffers instead of reallocating
+     * them. The CPTs kept are not cleared.
+     */
+    static void resize(vector<FactorizedCPT> &cpts, size_t count, size_t maxParents,
+            vector<FactorizedCPT> &spare);
+    virtual ~FactorizedCPT();
+};
+
+#endif /* OBJECTS_FACTORIZEDCPT_H_ */
@@ -0,0 +1,74 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_INFERENCEBACKEND_H_
+#define OBJECTS_INFERENCEBACKEND_H_
+
+#include <map>
+#include <vector>
+#include "FactorizedCPT.h"
+
+/*
+ * Common interface of the Bayesian network inference backends behind BNInferenceEngine.
+ * Nodes are binary and numbered densely from 0, see BayesianNetwork::BuildNetwork.
+ * Evidence is maintained incrementally: only an actual change of an evidence is passed to
+ * the backend through evidenceChanged, and the backend propagates the pending changes
+ * when a probability is queried next.
+ */
+class InferenceBackend {
+protected:
+    // current evidence of every node of the network: its state, 0 or 1, or -1 if not observed
+    std::vector<char> evidences;
+    // called after the evidence of node has been set, changed or retracted
+    virtual void evidenceChanged(long node) = 0;
+public:
+    virtual void BuildNetwork(long node_count,
+            const std::vector<FactorizedCPT> &cpts) = 0;
+    void setEvidence(long node, long state) {
+        if (evidences[node] == state) {
+            return;
+        }
+        evidences[node] = state;
+        evidenceChanged(node);
+    }
+    void retractEvidence(long node) {
+        if (evidences[node] >= 0) {
+            evidences[node] = -1;
+            evidenceChanged(node);
+        }
+    }
+    // replace the current evidences, where only the differences are applied
+    void buildSolution(const std::map<long, long> &evidences) {
+        for (size_t node = 0; node < this->evidences.size(); node++) {
+            if (!evidences.count(node)) {
+                retractEvidence(node);
+            }
+        }
+        for (auto &evidence : evidences) {
+            setEvidence(evidence.first, evidence.second);
+        }
+    }
+    virtual double getProbability(long node, long state) = 0;
+    // release the memory of the current solution, which is rebuilt by the next query
+    virtual void clearSolution() = 0;
+    // estimated error of the probabilities of the current solution, 0 for exact backends
+    virtual double getErrorEstimate() {
+        return 0;
+    }
+    virtual ~InferenceBackend() {
+    }
+};
+
+#endif /* OBJECTS_INFERENCEBACKEND_H_ */
@@ -0,0 +1,386 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <set>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <omnetpp.h>
+#include "JunctionTree.h"
+
+using namespace omnetpp;
+
+JunctionTree::JunctionTree() {
+    numOfNodes = 0;
+}
+
+JunctionTree::~JunctionTree() {
+    // TODO Auto-generated destructor stub
+}
+
+void JunctionTree::BuildNetwork(long node_count,
+        const std::vector<FactorizedCPT> &cpts) {
+    /*
+     * 1) decompose large CPTs the same way as the dlib backend,
+     * 2) triangulate the moral graph into elimination cliques,
+     * 3) multiply every CPT into the clique of its earliest eliminated family member,
+     * which contains the whole family.
+     */
+    numOfNodes = node_count;
+    evidences.assign(node_count, -1);
+    vector<FactorizedCPT> network = FactorizedCPT::decompose(cpts,
+            FactorizedCPT::MAX_TABLE_PARENTS);
+    _triangulate(network);
+    for (auto &cpt : network) {
+        _assign(cpt);
+    }
+
+    // every message is stale
+    pending = priority_queue<long, vector<long>, greater<long>>();
+    for (size_t r = 0; r < order.size(); r++) {
+        pending.push(r);
+    }
+    queued.assign(order.size(), 1);
+    for (long c = order.size() - 1; c >= 0; c--) {
+        Clique &clique = cliques[order[c]];
+        clique.root = clique.parent < 0 ? order[c] : cliques[clique.parent].root;
+        clique.changes = 0;
+        clique.upSeen = -1;
+        clique.downSeen = -1;
+        clique.beliefSeen = -1;
+    }
+}
+
+void JunctionTree::_triangulate(const vector<FactorizedCPT> &network) {
+    long total = network.size();
+    vector<std::set<long>> adj(total);
+    for (auto &cpt : network) {
+        for (size_t i = 0; i < cpt.parents.size(); i++) {
+            adj[cpt.node].insert(cpt.parents[i]);
+            adj[cpt.parents[i]].insert(cpt.node);
+            // moralize: marry the parents
+            for (size_t j = 0; j < i; j++) {
+                if (cpt.parents[i] != cpt.parents[j]) {
+                    adj[cpt.parents[i]].insert(cpt.parents[j]);
+                    adj[cpt.parents[j]].insert(cpt.parents[i]);
+                }
+            }
+        }
+    }
+
+    /*
+     * Min-degree elimination, stale heap entries are skipped when popped
+     */
+    cliques.assign(total, Clique());
+    order.clear();
+    vector<bool> eliminated(total, false);
+    typedef pair<size_t, long> entry;
+    priority_queue<entry, vector<entry>, greater<entry>> heap;
+    for (long v = 0; v < total; v++) {
+        heap.push(entry(adj[v].size(), v));
+    }
+    while (!heap.empty()) {
+        entry top = heap.top();
+        heap.pop();
+        long v = top.second;
+        if (eliminated[v] || top.first != adj[v].size()) {
+            continue;
+        }
+        eliminated[v] = true;
+        order.push_back(v);
+
+        Clique &clique = cliques[v];
+        clique.vars.assign(adj[v].begin(), adj[v].end());
+        clique.vars.insert(
+                lower_bound(clique.vars.begin(), clique.vars.end(), v), v);
+        if (clique.vars.size() > MAX_CLIQUE_SIZE) {
+            throw cRuntimeError(
+                    "Junction tree clique of node %ld has %d variables, more than %d",
+                    v, (int) clique.vars.size(), (int) MAX_CLIQUE_SIZE);
+        }
+        clique.pivot = lower_bound(clique.vars.begin(), clique.vars.end(), v)
+                - clique.vars.begin();
+
+        for (long a : adj[v]) {
+            adj[a].erase(v);
+            for (long b : adj[v]) {
+                if (a != b) {
+                    adj[a].insert(b);
+                }
+            }
+        }
+        for (long a : adj[v]) {
+            heap.push(entry(adj[a].size(), a));
+        }
+        adj[v].clear();
+    }
+
+    /*
+     * Link every clique to the clique of its first eliminated neighbour
+     */
+    rank.assign(total, 0);
+    for (size_t i = 0; i < order.size(); i++) {
+        rank[order[i]] = i;
+    }
+    for (long v : order) {
+        Clique &clique = cliques[v];
+        clique.parent = -1;
+        for (long u : clique.vars) {
+            if (u != v && (clique.parent < 0 || rank[u] < rank[clique.parent])) {
+                clique.parent = u;
+            }
+        }
+        size_t size = 1 << clique.vars.size();
+        clique.base.assign(size, 1);
+        clique.belief.assign(size, 0);
+        clique.up.assign(size / 2, 1);
+        clique.down.assign(size / 2, 1);
+        if (clique.parent < 0) {
+            continue;
+        }
+
+        Clique &parent = cliques[clique.parent];
+        parent.children.push_back(v);
+        vector<int> positions;
+        for (long u : clique.vars) {
+            if (u != v) {
+                positions.push_back(
+                        lower_bound(parent.vars.begin(), parent.vars.end(), u)
+                                - parent.vars.begin());
+            }
+        }
+        clique.parentMap.assign(1 << parent.vars.size(), 0);
+        for (size_t i = 0; i < clique.parentMap.size(); i++) {
+            int s = 0;
+            for (size_t q = 0; q < positions.size(); q++) {
+                s |= ((i >> positions[q]) & 1) << q;
+            }
+            clique.parentMap[i] = s;
+        }
+    }
+}
+
+void JunctionTree::_assign(const FactorizedCPT &cpt) {
+    long home = cpt.node;
+    for (long p : cpt.parents) {
+        if (rank[p] < rank[home]) {
+            home = p;
+        }
+    }
+    Clique &clique = cliques[home];
+    auto position = [&clique](long u) {
+        return (int) (lower_bound(clique.vars.begin(), clique.vars.end(), u)
+                - clique.vars.begin());
+    };
+    int self = position(cpt.node);
+    vector<int> positions;
+    for (long p : cpt.parents) {
+        positions.push_back(position(p));
+    }
+    for (size_t i = 0; i < clique.base.size(); i++) {
+        double p1 = cpt.probability([&](size_t k) {
+            return (i >> positions[k]) & 1;
+        });
+        clique.base[i] *= ((i >> self) & 1) ? p1 : 1 - p1;
+    }
+}
+
+void JunctionTree::evidenceChanged(long node) {
+    // the evidence of a node is entered in the node's own clique
+    for (long c = node; c >= 0; c = cliques[c].parent) {
+        cliques[c].changes++;
+    }
+    if (!queued[node]) {
+        queued[node] = 1;
+        pending.push(rank[node]);
+    }
+}
+
+bool JunctionTree::_upValid(long c) const {
+    return cliques[c].upSeen == cliques[c].changes;
+}
+
+bool JunctionTree::_downValid(long c) const {
+    const Clique &clique = cliques[c];
+    return clique.parent < 0
+            || clique.downSeen == cliques[clique.root].changes - clique.changes;
+}
+
+bool JunctionTree::_beliefValid(long c) const {
+    const Clique &clique = cliques[c];
+    return clique.beliefSeen == cliques[clique.root].changes;
+}
+
+void JunctionTree::_potential(long c, vector<double> &table) const {
+    const Clique &clique = cliques[c];
+    table = clique.base;
+    // auxiliary nodes of decomposed CPTs are never observed
+    if (c >= numOfNodes || evidences[c] < 0) {
+        return;
+    }
+    for (size_t i = 0; i < table.size(); i++) {
+        if ((long) ((i >> clique.pivot) & 1) != evidences[c]) {
+            table[i] = 0;
+        }
+    }
+}
+
+void JunctionTree::_normalize(vector<double> &table) {
+    double sum = 0;
+    for (double x : table) {
+        sum += x;
+    }
+    if (sum > 0) {
+        for (double &x : table) {
+            x /= sum;
+        }
+    }
+}
+
+void JunctionTree::_product(long c, long skip, bool withDown,
+        vector<double> &table) const {
+    const Clique &clique = cliques[c];
+    _potential(c, table);
+    if (withDown) {
+        size_t low = (1 << clique.pivot) - 1;
+        for (size_t i = 0; i < table.size(); i++) {
+            table[i] *= clique.down[((i >> 1) & ~low) | (i & low)];
+        }
+    }
+    for (long k : clique.children) {
+        if (k == skip) {
+            continue;
+        }
+        const Clique &child = cliques[k];
+        for (size_t i = 0; i < table.size(); i++) {
+            table[i] *= child.up[child.parentMap[i]];
+        }
+    }
+}
+
+void JunctionTree::_updateUp(long c) {
+    Clique &clique = cliques[c];
+    vector<double> &t = clique.belief;
+    _product(c, -1, false, t);
+    // sum out the clique's own node, i.e., the bit at pivot
+    size_t low = (1 << clique.pivot) - 1;
+    for (size_t s = 0; s < clique.up.size(); s++) {
+        size_t i = ((s & ~low) << 1) | (s & low);
+        clique.up[s] = t[i] + t[i | (low + 1)];
+    }
+    _normalize(clique.up);
+    clique.upSeen = clique.changes;
+    // belief is reused as scratch space
+    clique.beliefSeen = -1;
+}
+
+void JunctionTree::_updateDown(long c) {
+    Clique &clique = cliques[c];
+    bool divisible = true;
+    for (double x : clique.up) {
+        divisible = divisible && x > 0;
+    }
+
+    /*
+     * The message is the parent's belief without this clique's own message.
+     * Dividing it out of the parent's belief, which is shared by all children, is only
+     * exact without zeros; otherwise the product of the other messages is taken.
+     */
+    vector<double> &marginal = clique.down;
+    marginal.assign(marginal.size(), 0);
+    if (divisible) {
+        if (!_beliefValid(clique.parent)) {
+            _updateBelief(clique.parent);
+        }
+        const vector<double> &t = cliques[clique.parent].belief;
+        for (size_t i = 0; i < t.size(); i++) {
+            marginal[clique.parentMap[i]] += t[i];
+        }
+        for (size_t s = 0; s < marginal.size(); s++) {
+            marginal[s] /= clique.up[s];
+        }
+    } else {
+        vector<double> &t = scratch;
+        _product(clique.parent, c, true, t);
+        for (size_t i = 0; i < t.size(); i++) {
+            marginal[clique.parentMap[i]] += t[i];
+        }
+    }
+    _normalize(clique.down);
+    clique.downSeen = cliques[clique.root].changes - clique.changes;
+}
+
+void JunctionTree::_updateBelief(long c) {
+    Clique &clique = cliques[c];
+    _product(c, -1, true, clique.belief);
+    clique.beliefSeen = cliques[clique.root].changes;
+}
+
+double JunctionTree::getProbability(long node, long state) {
+    if (node < 0 || node >= numOfNodes) {
+        return 0;
+    }
+
+    /*
+     * 1) collect: stale messages towards the roots, in elimination order so that
+     * children come first, and each stale message queues the one of its parent
+     */
+    while (!pending.empty()) {
+        long c = order[pending.top()];
+        pending.pop();
+        queued[c] = 0;
+        if (_upValid(c)) {
+            continue;
+        }
+        _updateUp(c);
+        long parent = cliques[c].parent;
+        if (parent >= 0 && !queued[parent]) {
+            queued[parent] = 1;
+            pending.push(rank[parent]);
+        }
+    }
+
+    /*
+     * 2) distribute: messages from the root down to the queried clique only
+     */
+    path.clear();
+    for (long c = node; !_downValid(c); c = cliques[c].parent) {
+        path.push_back(c);
+    }
+    for (auto it = path.rbegin(); it != path.rend(); it++) {
+        _updateDown(*it);
+    }
+
+    /*
+     * 3) marginalize the belief of the node's own clique
+     */
+    Clique &clique = cliques[node];
+    if (!_beliefValid(node)) {
+        _updateBelief(node);
+    }
+    double p = 0;
+    double total = 0;
+    for (size_t i = 0; i < clique.belief.size(); i++) {
+        total += clique.belief[i];
+        if ((long) ((i >> clique.pivot) & 1) == state) {
+            p += clique.belief[i];
+        }
+    }
+    return total > 0 ? p / total : 0;
+}
+
+void JunctionTree::clearSolution() {
+    // the cliques, their tables and the valid messages are kept for the next query
+}
@@ -0,0 +1,115 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_JUNCTIONTREE_H_
+#define OBJECTS_JUNCTIONTREE_H_
+
+#include <map>
+#include <queue>
+#include <vector>
+#include <functional>
+#include "FactorizedCPT.h"
+#include "InferenceBackend.h"
+
+using namespace std;
+
+/*
+ * Native junction tree inference backend on flat arrays.
+ * The moral graph is triangulated by min-degree elimination, which yields one clique per
+ * node: the node plus its remaining neighbours when it is eliminated. The parent of the
+ * clique of v is the clique of the first node eliminated after v among its neighbours,
+ * and the separator between them is the clique of v without v itself.
+ * Potentials are dense tables of 2^k doubles, where bit j of an entry is the state of
+ * the j-th variable of the clique in ascending order. Messages are passed lazily: only
+ * the cliques on the path to a queried node are updated.
+ * An evidence change in clique c invalidates the messages to the parents on the path
+ * from c to its root, and the messages from the parents into every clique whose subtree
+ * does not contain c. Instead of visiting the latter, every clique counts the changes
+ * within its subtree, and a message from the parent is valid as long as the number of
+ * changes outside the subtree is the one it was computed with.
+ */
+class JunctionTree: public InferenceBackend {
+    // compiled from the cliques and their tables
+    friend class ArithmeticCircuit;
+private:
+    // cliques are limited to 2^MAX_CLIQUE_SIZE entries
+    static const size_t MAX_CLIQUE_SIZE = 24;
+    struct Clique {
+        // sorted BN node indices, the clique of node v contains v at position pivot
+        vector<long> vars;
+        int pivot;
+        // parent clique, -1 for the root of a connected component
+        long parent;
+        vector<long> children;
+        // parent entry -> separator entry
+        vector<int> parentMap;
+        // product of the CPTs assigned to the clique
+        vector<double> base;
+        // message to the parent and from the parent, both over the separator
+        vector<double> up;
+        vector<double> down;
+        // base x evidence x down x all messages from the children
+        vector<double> belief;
+        // root of the connected component
+        long root;
+        // number of evidence changes within the subtree
+        long changes;
+        // changes within the subtree, outside the subtree and in the component, respectively,
+        // when up, down and belief were computed, -1 if never
+        long upSeen;
+        long downSeen;
+        long beliefSeen;
+    };
+    // clique i is the elimination clique of node i
+    vector<Clique> cliques;
+    // elimination order, every clique comes before its parent
+    vector<long> order;
+    // position of every clique in order
+    vector<long> rank;
+    // ranks of the cliques whose message to the parent is stale, lowest first
+    priority_queue<long, vector<long>, greater<long>> pending;
+    vector<char> queued;
+    // table of the messages computed without a division
+    vector<double> scratch;
+    // cliques whose message from the parent is stale on the way to a queried clique
+    vector<long> path;
+    // number of nodes in the network before decomposition
+    long numOfNodes;
+
+    void _triangulate(const vector<FactorizedCPT> &network);
+    void _assign(const FactorizedCPT &cpt);
+    // base with the evidence of the clique's own node applied
+    void _potential(long c, vector<double> &table) const;
+    // potential x the message from the parent if withDown x the messages from the children but skip
+    void _product(long c, long skip, bool withDown, vector<double> &table) const;
+    void _updateUp(long c);
+    void _updateDown(long c);
+    void _updateBelief(long c);
+    bool _upValid(long c) const;
+    bool _downValid(long c) const;
+    bool _beliefValid(long c) const;
+    static void _normalize(vector<double> &table);
+protected:
+    virtual void evidenceChanged(long node) override;
+public:
+    virtual void BuildNetwork(long node_count,
+            const std::vector<FactorizedCPT> &cpts) override;
+    virtual double getProbability(long node, long state) override;
+    virtual void clearSolution() override;
+    JunctionTree();
+    virtual ~JunctionTree();
+};
+
+#endif /* OBJECTS_JUNCTIONTREE_H_ */
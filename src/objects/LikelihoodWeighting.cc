@@ -0,0 +1,186 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <chrono>
+#include <cmath>
+#include "LikelihoodWeighting.h"
+
+LikelihoodWeighting::LikelihoodWeighting(long maxSamples, double timeBudget,
+        cRNG *rng) {
+    this->maxSamples = maxSamples;
+    this->timeBudget = timeBudget;
+    this->rng = rng;
+    sumW = 0;
+    sumWSqr = 0;
+    samples = 0;
+    error = 0;
+    stale = true;
+}
+
+LikelihoodWeighting::~LikelihoodWeighting() {
+    // TODO Auto-generated destructor stub
+}
+
+void LikelihoodWeighting::BuildNetwork(long node_count,
+        const std::vector<FactorizedCPT> &cpts) {
+    // the subnetworks of BNInferenceEngine are rebuilt often, so every buffer is reused
+    size_t maxParents = 0;
+    for (auto &cpt : cpts) {
+        maxParents = max(maxParents, cpt.parents.size());
+    }
+    FactorizedCPT::resize(this->cpts, cpts.size(), maxParents, spareCpts);
+    for (size_t i = 0; i < cpts.size(); i++) {
+        this->cpts[i] = cpts[i];
+    }
+    evidences.assign(node_count, -1);
+    stale = true;
+
+    /*
+     * Topological order by Kahn's algorithm, where order doubles as the queue of the
+     * nodes ready to be visited
+     */
+    // children are counted in childStart[p + 2] so that filling them shifts the starts
+    childStart.assign(node_count + 2, 0);
+    inDegree.assign(node_count, 0);
+    for (auto &cpt : cpts) {
+        for (long p : cpt.parents) {
+            childStart[p + 2]++;
+            inDegree[cpt.node]++;
+        }
+    }
+    for (long v = 2; v < node_count + 2; v++) {
+        childStart[v] += childStart[v - 1];
+    }
+    children.resize(childStart[node_count + 1]);
+    for (auto &cpt : cpts) {
+        for (long p : cpt.parents) {
+            children[childStart[p + 1]++] = cpt.node;
+        }
+    }
+    order.clear();
+    for (long v = 0; v < node_count; v++) {
+        if (inDegree[v] == 0) {
+            order.push_back(v);
+        }
+    }
+    for (size_t head = 0; head < order.size(); head++) {
+        long v = order[head];
+        for (long k = childStart[v]; k < childStart[v + 1]; k++) {
+            if (--inDegree[children[k]] == 0) {
+                order.push_back(children[k]);
+            }
+        }
+    }
+    for (long v = 0; v < node_count; v++) {
+        if (inDegree[v] > 0) {
+            order.push_back(v);
+        }
+    }
+}
+
+void LikelihoodWeighting::evidenceChanged(long /*node*/) {
+    stale = true;
+}
+
+void LikelihoodWeighting::_sample() {
+    typedef std::chrono::steady_clock clock;
+    clock::time_point deadline = clock::now()
+            + std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(timeBudget));
+    stale = false;
+    long n = cpts.size();
+    const vector<char> &evidence = evidences;
+    sumW1.assign(n, 0);
+    sumW1Sqr.assign(n, 0);
+    sumW = 0;
+    sumWSqr = 0;
+
+    state.assign(n, 0);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (samples = 0; samples < maxSamples; samples++) {
+        if (timeBudget > 0 && samples > 0 && clock::now() >= deadline) {
+            break;
+        }
+        double w = 1;
+        for (long v : order) {
+            const FactorizedCPT &cpt = cpts[v];
+            double p1 = cpt.probability([&](size_t k) {
+                return state[cpt.parents[k]];
+            });
+            if (evidence[v] >= 0) {
+                state[v] = evidence[v];
+                w *= state[v] ? p1 : 1 - p1;
+            } else {
+                double u = rng ? rng->doubleRand() : uniform(defaultRng);
+                state[v] = u < p1;
+            }
+        }
+        sumW += w;
+        sumWSqr += w * w;
+        for (long v = 0; v < n; v++) {
+            if (state[v]) {
+                sumW1[v] += w;
+                sumW1Sqr[v] += w * w;
+            }
+        }
+    }
+
+    /*
+     * Standard error of the self-normalized estimate p = sum(w x) / sum(w):
+     * var(p) ~ sum(w^2 (x - p)^2) / sum(w)^2, where x is 0 or 1
+     */
+    // without any sample consistent with the evidence, nothing is known
+    error = sumW > 0 ? 0 : 1;
+    for (long v = 0; v < n; v++) {
+        if (evidence[v] >= 0 || sumW <= 0) {
+            continue;
+        }
+        double p = sumW1[v] / sumW;
+        double sqr = sumW1Sqr[v] * (1 - 2 * p) + p * p * sumWSqr;
+        error = max(error, sqrt(max(sqr, 0.0)) / sumW);
+    }
+}
+
+double LikelihoodWeighting::getProbability(long node, long state) {
+    if (stale) {
+        _sample();
+    }
+    if (node < 0 || node >= (long) sumW1.size()) {
+        return 0;
+    }
+    if (evidences[node] >= 0) {
+        return evidences[node] == state ? 1 : 0;
+    }
+    if (sumW <= 0) {
+        return 0;
+    }
+    double p1 = sumW1[node] / sumW;
+    return state ? p1 : 1 - p1;
+}
+
+void LikelihoodWeighting::clearSolution() {
+    // the estimates are overwritten by the next solution
+}
+
+double LikelihoodWeighting::getErrorEstimate() {
+    if (stale) {
+        _sample();
+    }
+    return error;
+}
+
+long LikelihoodWeighting::numOfSamples() {
+    return samples;
+}
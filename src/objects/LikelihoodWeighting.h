@@ -0,0 +1,82 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_LIKELIHOODWEIGHTING_H_
+#define OBJECTS_LIKELIHOODWEIGHTING_H_
+
+#include <map>
+#include <random>
+#include <vector>
+#include <omnetpp.h>
+#include "FactorizedCPT.h"
+#include "InferenceBackend.h"
+
+using namespace std;
+using namespace omnetpp;
+
+/*
+ * Approximate inference backend by likelihood-weighted sampling.
+ * Every sample draws the non-evidence nodes in topological order from their factorized
+ * CPTs and is weighted by the likelihood of the evidence, so its cost is linear in the
+ * number of relations regardless of the treewidth of the network.
+ * Sampling stops at maxSamples samples. An optional timeBudget in seconds of wall-clock
+ * time, 0 for none, stops it earlier at the cost of reproducibility. Samples are drawn
+ * from the given RNG, or from a default-seeded generator without one, and are drawn
+ * again on the first query after an evidence change only.
+ */
+class LikelihoodWeighting: public InferenceBackend {
+private:
+    vector<FactorizedCPT> cpts;
+    // CPTs of a larger network built before, whose buffers are reused
+    vector<FactorizedCPT> spareCpts;
+    // nodes in topological order, nodes on a cycle are appended in index order
+    vector<long> order;
+    // children of node v are children[childStart[v]..childStart[v + 1]), in CSR form
+    vector<long> childStart;
+    vector<long> children;
+    vector<long> inDegree;
+    // node states of the current sample
+    vector<char> state;
+    long maxSamples;
+    double timeBudget;
+    // not owned, e.g., an RNG of the simulation
+    cRNG *rng;
+    std::mt19937 defaultRng;
+    // whether the evidences changed since the last sampling
+    bool stale;
+    // per node sums of the weights of the samples with the node triggered, and their squares
+    vector<double> sumW1;
+    vector<double> sumW1Sqr;
+    double sumW;
+    double sumWSqr;
+    long samples;
+    double error;
+
+    void _sample();
+protected:
+    virtual void evidenceChanged(long node) override;
+public:
+    LikelihoodWeighting(long maxSamples, double timeBudget, cRNG *rng = nullptr);
+    virtual void BuildNetwork(long node_count,
+            const std::vector<FactorizedCPT> &cpts) override;
+    virtual double getProbability(long node, long state) override;
+    virtual void clearSolution() override;
+    // largest standard error of the estimated probabilities of the non-evidence nodes
+    virtual double getErrorEstimate() override;
+    long numOfSamples();
+    virtual ~LikelihoodWeighting();
+};
+
+#endif /* OBJECTS_LIKELIHOODWEIGHTING_H_ */
@@ -0,0 +1,405 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <cstring>
+#include <fstream>
+#include <omnetpp.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "ModelImage.h"
+
+using namespace omnetpp;
+using boost::interprocess::file_mapping;
+using boost::interprocess::mapped_region;
+using boost::interprocess::interprocess_exception;
+using boost::interprocess::read_only;
+
+static const char MAGIC[8] = "SGIMAGE";
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+bool ModelImage::_fingerprint(const string &modelPath, uint64_t &size,
+        uint64_t &hash) {
+    try {
+        file_mapping file(modelPath.c_str(), read_only);
+        mapped_region region(file, read_only);
+        const unsigned char *data =
+                static_cast<const unsigned char*>(region.get_address());
+        size = region.get_size();
+        hash = 14695981039346656037ULL;
+        for (uint64_t i = 0; i < size; i++) {
+            hash = (hash ^ data[i]) * 1099511628211ULL;
+        }
+        return true;
+    } catch (const interprocess_exception &e) {
+        return false;
+    }
+}
+
+template<typename T>
+void ModelImage::_write(vector<char> &image, const vector<T> &values) {
+    uint64_t count = values.size();
+    uint64_t bytes = count * sizeof(T);
+    size_t pos = image.size();
+    image.resize(pos + sizeof(count) + (bytes + 7) / 8 * 8, 0);
+    memcpy(&image[pos], &count, sizeof(count));
+    if (bytes > 0) {
+        memcpy(&image[pos + sizeof(count)], values.data(), bytes);
+    }
+}
+
+template<typename T>
+bool ModelImage::_read(const char *&pos, const char *end, vector<T> &values) {
+    uint64_t count;
+    if ((uint64_t) (end - pos) < sizeof(count)) {
+        return false;
+    }
+    memcpy(&count, pos, sizeof(count));
+    pos += sizeof(count);
+    if (count > (uint64_t) (end - pos) / sizeof(T)) {
+        return false;
+    }
+    uint64_t bytes = count * sizeof(T);
+    uint64_t padded = (bytes + 7) / 8 * 8;
+    if (padded > (uint64_t) (end - pos)) {
+        return false;
+    }
+    values.resize(count);
+    if (bytes > 0) {
+        memcpy(values.data(), pos, bytes);
+    }
+    pos += padded;
+    return true;
+}
+
+// whether offsets delimit a CSR with the given number of rows over targets
+static bool _isCSR(const vector<int32_t> &offsets, size_t rows, size_t targets) {
+    if (offsets.size() != rows + 1 || offsets[0] != 0
+            || (size_t) offsets[rows] != targets) {
+        return false;
+    }
+    for (size_t i = 0; i < rows; i++) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+string ModelImage::imagePathOf(const string &modelPath) {
+    size_t dot = modelPath.find_last_of('.');
+    size_t slash = modelPath.find_last_of("/\\");
+    if (dot == string::npos || (slash != string::npos && dot < slash)) {
+        return modelPath + ".sgb";
+    }
+    return modelPath.substr(0, dot) + ".sgb";
+}
+
+void ModelImage::save(const SituationGraph &sg, const string &modelPath,
+        const string &imagePath) {
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    if (!_fingerprint(modelPath, header.modelSize, header.modelHash)) {
+        throw cRuntimeError("Cannot read model %s", modelPath.c_str());
+    }
+    vector<char> image(sizeof(header));
+
+    /*
+     * 1. Node table, in SituationNode::index order
+     */
+    size_t n = sg.nodes.size();
+    vector<int64_t> ids(n);
+    vector<int32_t> layers(n);
+    vector<int32_t> types(n);
+    vector<double> thresholds(n);
+    vector<double> durations(n);
+    vector<double> cycles(n);
+    for (size_t i = 0; i < n; i++) {
+        const SituationNode &node = sg.nodes[i];
+        ids[i] = node.id;
+        layers[i] = node.layer;
+        types[i] = node.type;
+        thresholds[i] = node.threshold;
+        durations[i] = SIMTIME_DBL(node.duration);
+        cycles[i] = SIMTIME_DBL(node.cycle);
+    }
+    _write(image, ids);
+    _write(image, layers);
+    _write(image, types);
+    _write(image, thresholds);
+    _write(image, durations);
+    _write(image, cycles);
+
+    /*
+     * 2. Causes, evidences, parents and implicit causes of each node as dense indices,
+     * in CSR form
+     */
+    vector<int32_t> offsets;
+    vector<int32_t> targets;
+    for (int list = 0; list < 4; list++) {
+        offsets.assign(1, 0);
+        targets.clear();
+        for (size_t i = 0; i < n; i++) {
+            const SituationNode &node = sg.nodes[i];
+            const vector<int> &situations =
+                    list == 0 ? node.causes :
+                    list == 1 ? node.evidences :
+                    list == 2 ? node.parents : sg.implicitCauses[i];
+            targets.insert(targets.end(), situations.begin(), situations.end());
+            offsets.push_back(targets.size());
+        }
+        _write(image, offsets);
+        _write(image, targets);
+    }
+
+    /*
+     * 3. Relation table, in edge order
+     */
+    vector<int64_t> srcs;
+    vector<int64_t> dests;
+    vector<int32_t> relationTypes;
+    vector<int32_t> relations;
+    vector<double> weights;
+    for (auto &entry : sg.relationMap) {
+        srcs.push_back(entry.first.first);
+        dests.push_back(entry.first.second);
+        relationTypes.push_back(entry.second.type);
+        relations.push_back(entry.second.relation);
+        weights.push_back(entry.second.weight);
+    }
+    _write(image, srcs);
+    _write(image, dests);
+    _write(image, relationTypes);
+    _write(image, relations);
+    _write(image, weights);
+
+    /*
+     * 4. Layers in their frozen CSR form
+     */
+    _write(image, vector<int64_t>(1, sg.layers.size()));
+    for (auto &graph : sg.layers) {
+        if (!graph.isFinalized()) {
+            throw cRuntimeError("Layers of model %s are not finalized",
+                    modelPath.c_str());
+        }
+        _write(image, vector<int64_t>(graph.vertexIds.begin(),
+                graph.vertexIds.end()));
+        _write(image, graph.offsets);
+        _write(image, graph.targets);
+    }
+
+    /*
+     * 5. Reachability bitsets
+     */
+    vector<int32_t> dimensions = { sg.ri.size, sg.ri.words };
+    _write(image, dimensions);
+    _write(image, sg.ri.component);
+    _write(image, sg.ri.cyclic);
+    _write(image, sg.ri.closure);
+
+    header.imageSize = image.size();
+    memcpy(&image[0], &header, sizeof(header));
+    std::ofstream f(imagePath, std::ios::binary | std::ios::trunc);
+    f.write(image.data(), image.size());
+    if (!f) {
+        throw cRuntimeError("Cannot write model image %s", imagePath.c_str());
+    }
+}
+
+shared_ptr<SituationGraph> ModelImage::load(const string &modelPath,
+        const string &imagePath) {
+    try {
+        file_mapping file(imagePath.c_str(), read_only);
+        mapped_region region(file, read_only);
+        const char *pos = static_cast<const char*>(region.get_address());
+        const char *end = pos + region.get_size();
+
+        /*
+         * 1. Reject images of another format or platform, truncated ones and stale
+         * ones, whose model has changed since compilation
+         */
+        Header header;
+        if (region.get_size() < sizeof(header)) {
+            return nullptr;
+        }
+        memcpy(&header, pos, sizeof(header));
+        pos += sizeof(header);
+        uint64_t modelSize, modelHash;
+        if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0
+                || header.version != FORMAT_VERSION
+                || header.byteOrder != BYTE_ORDER_MARK
+                || header.imageSize != region.get_size()
+                || !_fingerprint(modelPath, modelSize, modelHash)
+                || modelSize != header.modelSize
+                || modelHash != header.modelHash) {
+            return nullptr;
+        }
+
+        /*
+         * 2. Node table
+         */
+        shared_ptr<SituationGraph> sg = make_shared<SituationGraph>();
+        vector<int64_t> ids;
+        vector<int32_t> layers;
+        vector<int32_t> types;
+        vector<double> thresholds;
+        vector<double> durations;
+        vector<double> cycles;
+        if (!_read(pos, end, ids) || !_read(pos, end, layers)
+                || !_read(pos, end, types) || !_read(pos, end, thresholds)
+                || !_read(pos, end, durations) || !_read(pos, end, cycles)) {
+            return nullptr;
+        }
+        size_t n = ids.size();
+        if (layers.size() != n || types.size() != n || thresholds.size() != n
+                || durations.size() != n || cycles.size() != n) {
+            return nullptr;
+        }
+        sg->nodes.resize(n);
+        sg->indexMap.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            SituationNode &node = sg->nodes[i];
+            node.id = ids[i];
+            node.index = i;
+            node.layer = layers[i];
+            node.type = (SituationInstance::Type) types[i];
+            node.threshold = thresholds[i];
+            node.duration = SimTime(durations[i]);
+            node.cycle = SimTime(cycles[i]);
+            sg->indexMap[node.id] = i;
+        }
+
+        /*
+         * 3. Causes, evidences, parents and implicit causes, as dense indices
+         */
+        vector<int32_t> offsets;
+        vector<int32_t> targets;
+        sg->implicitCauses.assign(n, vector<int>());
+        for (int list = 0; list < 4; list++) {
+            if (!_read(pos, end, offsets) || !_read(pos, end, targets)
+                    || !_isCSR(offsets, n, targets.size())) {
+                return nullptr;
+            }
+            for (auto target : targets) {
+                if (target < 0 || (size_t) target >= n) {
+                    return nullptr;
+                }
+            }
+            for (size_t i = 0; i < n; i++) {
+                SituationNode &node = sg->nodes[i];
+                vector<int> &situations =
+                        list == 0 ? node.causes :
+                        list == 1 ? node.evidences :
+                        list == 2 ? node.parents : sg->implicitCauses[i];
+                situations.assign(targets.begin() + offsets[i],
+                        targets.begin() + offsets[i + 1]);
+            }
+        }
+
+        /*
+         * 4. Relation table, inserted in edge order
+         */
+        vector<int64_t> srcs;
+        vector<int64_t> dests;
+        vector<int32_t> relationTypes;
+        vector<int32_t> relations;
+        vector<double> weights;
+        if (!_read(pos, end, srcs) || !_read(pos, end, dests)
+                || !_read(pos, end, relationTypes)
+                || !_read(pos, end, relations) || !_read(pos, end, weights)) {
+            return nullptr;
+        }
+        size_t m = srcs.size();
+        if (dests.size() != m || relationTypes.size() != m
+                || relations.size() != m || weights.size() != m) {
+            return nullptr;
+        }
+        for (size_t k = 0; k < m; k++) {
+            SituationRelation relation;
+            relation.src = srcs[k];
+            relation.dest = dests[k];
+            relation.type = (SituationRelation::Type) relationTypes[k];
+            relation.relation = (SituationRelation::Relation) relations[k];
+            relation.weight = weights[k];
+            sg->relationMap.emplace_hint(sg->relationMap.end(),
+                    SituationGraph::edge_id(relation.src, relation.dest),
+                    relation);
+        }
+
+        /*
+         * 5. Layers
+         */
+        vector<int64_t> numOfLayers;
+        if (!_read(pos, end, numOfLayers) || numOfLayers.size() != 1) {
+            return nullptr;
+        }
+        sg->layers.resize(numOfLayers[0]);
+        for (auto &graph : sg->layers) {
+            vector<int64_t> vertexIds;
+            if (!_read(pos, end, vertexIds) || !_read(pos, end, graph.offsets)
+                    || !_read(pos, end, graph.targets)
+                    || !_isCSR(graph.offsets, vertexIds.size(),
+                            graph.targets.size())) {
+                return nullptr;
+            }
+            graph.vertexIds.assign(vertexIds.begin(), vertexIds.end());
+            graph.vertexIndex.reserve(vertexIds.size());
+            for (size_t i = 0; i < vertexIds.size(); i++) {
+                graph.vertexIndex[vertexIds[i]] = i;
+            }
+            for (auto target : graph.targets) {
+                if (target < 0 || (size_t) target >= vertexIds.size()) {
+                    return nullptr;
+                }
+            }
+            graph.finalized = true;
+            for (auto id : vertexIds) {
+                if (sg->indexOf(id) < 0) {
+                    return nullptr;
+                }
+            }
+        }
+        sg->_buildLayerOrders();
+
+        /*
+         * 6. Reachability bitsets
+         */
+        vector<int32_t> dimensions;
+        ReachabilityIndex &ri = sg->ri;
+        if (!_read(pos, end, dimensions) || dimensions.size() != 2
+                || !_read(pos, end, ri.component) || !_read(pos, end, ri.cyclic)
+                || !_read(pos, end, ri.closure)) {
+            return nullptr;
+        }
+        ri.size = dimensions[0];
+        ri.words = dimensions[1];
+        if ((size_t) ri.size != n || ri.component.size() != n
+                || ri.closure.size() != ri.cyclic.size() * ri.words) {
+            return nullptr;
+        }
+        for (auto c : ri.component) {
+            if (c < 0 || (size_t) c >= ri.cyclic.size()) {
+                return nullptr;
+            }
+        }
+        return sg;
+    } catch (const interprocess_exception &e) {
+        // no image
+        return nullptr;
+    }
+}
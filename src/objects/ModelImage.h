@@ -0,0 +1,72 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef OBJECTS_MODELIMAGE_H_
+#define OBJECTS_MODELIMAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Precompiled binary image of a situation graph model. The image holds everything
+ * loadModel derives from the JSON model: dense node table, CSR cause, evidence and
+ * parent lists of dense indices, relation table, CSR layers, reachability bitsets and
+ * implicit causes, so that loading it is a memory-mapped copy without parsing or
+ * recomputation.
+ *
+ * An image records the format version and the size and hash of the JSON model it was
+ * compiled from, and is rejected as stale if any of them does not match.
+ */
+class ModelImage {
+public:
+    // to be increased on any change of the image layout
+    static const uint32_t FORMAT_VERSION = 2;
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        // written as 0x01020304 in native order, to reject images of other platforms
+        uint32_t byteOrder;
+        uint64_t modelSize;
+        uint64_t modelHash;
+        // size of the whole image, to reject truncated ones
+        uint64_t imageSize;
+    };
+    // size and FNV-1a hash of the model file, false if it cannot be read
+    static bool _fingerprint(const string &modelPath, uint64_t &size,
+            uint64_t &hash);
+    // a section is a 64-bit element count followed by the elements, padded to 8 bytes
+    template<typename T>
+    static void _write(vector<char> &image, const vector<T> &values);
+    template<typename T>
+    static bool _read(const char *&pos, const char *end, vector<T> &values);
+public:
+    // image file of a model, e.g., files/SG.sgb for files/SG.json
+    static string imagePathOf(const string &modelPath);
+    // compile the graph loaded from a model file into an image
+    static void save(const SituationGraph &sg, const string &modelPath,
+            const string &imagePath);
+    // the graph of an image, or null if the image is missing, corrupt or stale
+    static shared_ptr<SituationGraph> load(const string &modelPath,
+            const string &imagePath);
+};
+
+#endif /* OBJECTS_MODELIMAGE_H_ */
@@ -0,0 +1,289 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <omnetpp.h>
+#include "ModelParser.h"
+
+using namespace omnetpp;
+
+ModelParser::ModelParser(SituationGraph &sg) :
+        sg(sg) {
+    predecessors = false;
+    id = -1;
+    duration = 0;
+    type = 0;
+    cycle = 0;
+    hasId = hasDuration = hasType = hasCycle = false;
+    entry = RelationEntry();
+    index = sg.nodes.size();
+}
+
+ModelParser::~ModelParser() {
+    // TODO Auto-generated destructor stub
+}
+
+void ModelParser::parse(std::istream &input, const std::string &filename) {
+    if (!json::sax_parse(input, this)) {
+        throw cRuntimeError("Cannot load model %s: %s", filename.c_str(),
+                error.c_str());
+    }
+}
+
+bool ModelParser::_number(long integer, double real) {
+    if (contexts.empty()) {
+        return true;
+    }
+    if (contexts.back() == NODE) {
+        if (lastKey == "ID") {
+            id = integer;
+            hasId = true;
+        } else if (lastKey == "Duration") {
+            duration = real;
+            hasDuration = true;
+        } else if (lastKey == "type") {
+            type = integer;
+            hasType = true;
+        } else if (lastKey == "Cycle") {
+            cycle = real;
+            hasCycle = true;
+        }
+    } else if (contexts.back() == RELATION) {
+        if (lastKey == "ID") {
+            entry.id = integer;
+            entry.hasId = true;
+        } else if (lastKey == (predecessors ? "Weight-x" : "Weight-y")) {
+            entry.weight = real;
+            entry.hasWeight = true;
+        } else if (lastKey == "Relation") {
+            entry.relation = integer;
+            entry.hasRelation = true;
+        }
+    }
+    return true;
+}
+
+bool ModelParser::_addSituation() {
+    if (!hasId || !hasDuration || !hasType) {
+        error = "situation without ID, Duration or type";
+        return false;
+    }
+    if (sg.indexMap.count(id)) {
+        error = "duplicate situation ID " + to_string(id);
+        return false;
+    }
+
+    SituationNode situation;
+    situation.id = id;
+    situation.index = index;
+    situation.layer = sg.layers.size();
+    sg.indexMap[id] = index;
+    causeIds.resize(index + 1);
+    evidenceIds.resize(index + 1);
+    vector<long> &situationCauses = causeIds[index];
+    vector<long> &situationEvidences = evidenceIds[index];
+    index++;
+
+    situation.duration = SimTime(duration / 1000.0);
+    situation.type = (SituationInstance::Type) type;
+    if (hasCycle) {
+        // cycle is in millisecond
+        situation.cycle = SimTime(cycle / 1000.0);
+    }
+
+    /*
+     * 1.1.1 build cause-consequence relations
+     */
+    for (auto &pre : causes) {
+        SituationRelation relation;
+        long src = pre.id;
+        relation.src = src;
+        relation.dest = situation.id;
+        situationCauses.push_back(src);
+        relation.type = SituationRelation::H;
+        switch (pre.relation) {
+        case 1:
+            relation.relation = SituationRelation::AND;
+            break;
+        case 2:
+            relation.relation = SituationRelation::OR;
+            break;
+        default:
+            relation.relation = SituationRelation::SOLE;
+        }
+        relation.weight = pre.weight;
+        SituationGraph::edge_id eid;
+        eid.first = src;
+        eid.second = relation.dest;
+        sg.relationMap[eid] = relation;
+    }
+
+    /*
+     * 1.1.2 build parent-child relations
+     */
+    for (auto &chd : evidences) {
+        SituationRelation relation;
+        long src = chd.id;
+        relation.src = src;
+        relation.dest = situation.id;
+        situationEvidences.push_back(src);
+        relation.type = SituationRelation::V;
+        switch (chd.relation) {
+        case 1:
+            relation.relation = SituationRelation::AND;
+            break;
+        case 2:
+            relation.relation = SituationRelation::OR;
+            break;
+        default:
+            relation.relation = SituationRelation::SOLE;
+        }
+        relation.weight = chd.weight;
+        SituationGraph::edge_id eid;
+        eid.first = src;
+        eid.second = relation.dest;
+        sg.relationMap[eid] = relation;
+    }
+
+    layerMap[situation.id] = situation.index;
+    sg.nodes.push_back(situation);
+    return true;
+}
+
+void ModelParser::_addLayer() {
+    /*
+     * 1.2 Construct SG layers
+     */
+    sg.layers.push_back(DirectedGraph());
+    DirectedGraph &graph = sg.layers.back();
+    for (auto m : layerMap) {
+        graph.add_vertex(m.first);
+        for (auto p : causeIds[m.second]) {
+            graph.add_edge(p, m.first);
+        }
+    }
+    // layers are not modified after loading
+    graph.finalize();
+}
+
+bool ModelParser::null() {
+    if (!contexts.empty() && contexts.back() == NODE) {
+        if (lastKey == "Cycle") {
+            hasCycle = false;
+        } else if (lastKey == "Predecessors") {
+            causes.clear();
+        } else if (lastKey == "Children") {
+            evidences.clear();
+        }
+    }
+    return true;
+}
+
+bool ModelParser::boolean(bool /*val*/) {
+    return true;
+}
+
+bool ModelParser::number_integer(json::number_integer_t val) {
+    return _number(val, val);
+}
+
+bool ModelParser::number_unsigned(json::number_unsigned_t val) {
+    return _number(val, val);
+}
+
+bool ModelParser::number_float(json::number_float_t val,
+        const json::string_t& /*s*/) {
+    return _number((long) val, val);
+}
+
+bool ModelParser::string(json::string_t& /*val*/) {
+    return true;
+}
+
+#if NLOHMANN_JSON_VERSION_MAJOR > 3 || (NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 8)
+bool ModelParser::binary(json::binary_t& /*val*/) {
+    return true;
+}
+#endif
+
+bool ModelParser::start_object(std::size_t /*elements*/) {
+    if (contexts.empty()) {
+        contexts.push_back(ROOT);
+    } else if (contexts.back() == LAYER) {
+        contexts.push_back(NODE);
+        hasId = hasDuration = hasType = hasCycle = false;
+        causes.clear();
+        evidences.clear();
+    } else if (contexts.back() == RELATIONS) {
+        contexts.push_back(RELATION);
+        entry = RelationEntry();
+    } else {
+        contexts.push_back(SKIPPED);
+    }
+    return true;
+}
+
+bool ModelParser::key(json::string_t &val) {
+    lastKey = val;
+    return true;
+}
+
+bool ModelParser::end_object() {
+    Context context = contexts.back();
+    contexts.pop_back();
+    if (context == NODE) {
+        return _addSituation();
+    } else if (context == RELATION) {
+        if (!entry.hasId || !entry.hasWeight || !entry.hasRelation) {
+            error = "relation without ID, weight or Relation";
+            return false;
+        }
+        (predecessors ? causes : evidences).push_back(entry);
+    }
+    return true;
+}
+
+bool ModelParser::start_array(std::size_t /*elements*/) {
+    Context context = contexts.empty() ? SKIPPED : contexts.back();
+    if (context == ROOT && lastKey == "layers") {
+        contexts.push_back(LAYERS);
+    } else if (context == LAYERS) {
+        contexts.push_back(LAYER);
+        layerMap.clear();
+    } else if (context == NODE
+            && (lastKey == "Predecessors" || lastKey == "Children")) {
+        contexts.push_back(RELATIONS);
+        predecessors = lastKey == "Predecessors";
+        (predecessors ? causes : evidences).clear();
+    } else {
+        contexts.push_back(SKIPPED);
+    }
+    return true;
+}
+
+bool ModelParser::end_array() {
+    Context context = contexts.back();
+    contexts.pop_back();
+    if (context == LAYER) {
+        _addLayer();
+    }
+    return true;
+}
+
+bool ModelParser::parse_error(std::size_t /*position*/,
+        const std::string& /*last_token*/, const nlohmann::detail::exception &ex) {
+    error = ex.what();
+    return false;
+}
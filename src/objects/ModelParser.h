@@ -0,0 +1,117 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef OBJECTS_MODELPARSER_H_
+#define OBJECTS_MODELPARSER_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "SituationGraph.h"
+
+using namespace std;
+using json = nlohmann::json;
+
+/*
+ * Streaming (SAX) parser of situation graph models. Situation nodes, relations and
+ * layers are added to the graph as soon as their JSON object or array is complete,
+ * so no JSON document is built and the memory held by the parser is bounded by a
+ * single situation.
+ */
+class ModelParser {
+private:
+    // JSON container being parsed; containers of unknown keys are skipped
+    enum Context {
+        ROOT, LAYERS, LAYER, NODE, RELATIONS, RELATION, SKIPPED
+    };
+    // a Predecessors or Children entry, buffered until its situation is complete
+    struct RelationEntry {
+        long id;
+        double weight;
+        short relation;
+        bool hasId;
+        bool hasWeight;
+        bool hasRelation;
+    };
+
+    SituationGraph &sg;
+    vector<Context> contexts;
+    // last key of the object being parsed
+    std::string lastKey;
+    // whether the relations being parsed are Predecessors, otherwise Children
+    bool predecessors;
+    std::string error;
+
+    /*
+     * Situation being parsed
+     */
+    long id;
+    double duration;
+    short type;
+    double cycle;
+    bool hasId;
+    bool hasDuration;
+    bool hasType;
+    bool hasCycle;
+    vector<RelationEntry> causes;
+    vector<RelationEntry> evidences;
+    RelationEntry entry;
+
+    // next SituationNode::index
+    int index;
+    // <situation ID, index> of the layer being parsed, sorted by ID
+    std::map<long, int> layerMap;
+
+    bool _number(long integer, double real);
+    bool _addSituation();
+    void _addLayer();
+public:
+    /*
+     * Causes and evidences of each situation by ID, indexed by SituationNode::index, to be
+     * resolved to dense indices once every situation of the model is known
+     */
+    vector<vector<long>> causeIds;
+    vector<vector<long>> evidenceIds;
+
+    ModelParser(SituationGraph &sg);
+    // parse a model into the graph, throwing cRuntimeError on malformed models
+    void parse(std::istream &input, const std::string &filename);
+
+    /*
+     * SAX events
+     */
+    bool null();
+    bool boolean(bool val);
+    bool number_integer(json::number_integer_t val);
+    bool number_unsigned(json::number_unsigned_t val);
+    bool number_float(json::number_float_t val, const json::string_t &s);
+    bool string(json::string_t &val);
+#if NLOHMANN_JSON_VERSION_MAJOR > 3 || (NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 8)
+    bool binary(json::binary_t &val);
+#endif
+    bool start_object(std::size_t elements);
+    bool key(json::string_t &val);
+    bool end_object();
+    bool start_array(std::size_t elements);
+    bool end_array();
+    bool parse_error(std::size_t position, const std::string &last_token,
+            const nlohmann::detail::exception &ex);
+    virtual ~ModelParser();
+};
+
+#endif /* OBJECTS_MODELPARSER_H_ */
@@ -0,0 +1,37 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include "ModelImage.h"
+#include "ModelRegistry.h"
+
+map<string, weak_ptr<const SituationGraph>> ModelRegistry::models;
+
+shared_ptr<const SituationGraph> ModelRegistry::load(const string &filename) {
+    weak_ptr<const SituationGraph> &entry = models[filename];
+    shared_ptr<const SituationGraph> sg = entry.lock();
+    if (!sg) {
+        // a precompiled image is preferred unless the model changed since compilation
+        shared_ptr<SituationGraph> loaded = ModelImage::load(filename,
+                ModelImage::imagePathOf(filename));
+        if (!loaded) {
+            loaded = make_shared<SituationGraph>();
+            loaded->loadModel(filename);
+        }
+        sg = loaded;
+        entry = sg;
+    }
+    return sg;
+}
@@ -0,0 +1,40 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef OBJECTS_MODELREGISTRY_H_
+#define OBJECTS_MODELREGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Situation graphs loaded in the process, by model file. A model is parsed and indexed
+ * once, or restored from its precompiled image, then shared read-only by every module
+ * using it, and released with its last handle.
+ */
+class ModelRegistry {
+private:
+    static map<string, weak_ptr<const SituationGraph>> models;
+public:
+    // the model of the file, loaded on first use
+    static shared_ptr<const SituationGraph> load(const string &filename);
+};
+
+#endif /* OBJECTS_MODELREGISTRY_H_ */
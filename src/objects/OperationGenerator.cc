@@ -13,14 +13,15 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include "../common/Logger.h"
 #include "../common/Util.h"
 #include "OperationGenerator.h"
 
 OperationGenerator::OperationGenerator() {
-
+    se = NULL;
 }
 
-void OperationGenerator::setModel(SituationGraph sg){
+void OperationGenerator::setModel(std::shared_ptr<const SituationGraph> sg){
     this->sg = sg;
 }
 
@@ -37,7 +38,7 @@ void OperationGenerator::cacheEvent(long eventId, bool toTrigger,
     eventQueues[eventId].push_back(event);
 }
 
-queue<vector<VirtualOperation>> OperationGenerator::generateOperations(set<long> cycleTriggered) {
+queue<vector<VirtualOperation>> OperationGenerator::generateOperations(const vector<long>& /*cycleTriggered*/) {
     /*
      * 1. Operation generation
      */
@@ -59,8 +60,11 @@ queue<vector<VirtualOperation>> OperationGenerator::generateOperations(set<long>
 
     //    cout << "mergedEvents: ";
     //    util::printMap(mergedEvents);
-        cout << "print eventQueues: " << endl;
-        util::printComplexMap(eventQueues);
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        Logger::Record record;
+        record.stream() << "print eventQueues: " << endl;
+        util::printComplexMap(eventQueues, record.stream());
+    }
 
     // remove the first event from cache, which is supposed to be transmitted to simulator
     for(auto a : toRemoveFront){
@@ -93,27 +97,28 @@ queue<vector<VirtualOperation>> OperationGenerator::generateOperations(set<long>
         hasCause = false;
         map<long, VirtualOperation>& topMap = sorted.top();
         map<long, VirtualOperation> newVoMap;
-        for(auto vo : topMap){
+        for(auto &vo : topMap){
             long id = vo.first;
-            SituationNode node = sg.getNode(id);
-            SituationInstance& instance = se->getInstance(id);
+            int index = sg->indexOf(id);
+            SituationInstance& instance = se->getInstanceAt(index);
 
             /*
              * search for vo's cause situations
              */
             // a flag indicating whether a situation has a cause in the same slice
             bool sameSlice = false;
-            for(auto& vo1 : topMap){
-                if(vo1.first != id && sg.isReachable(vo1.first, id) && !sg.isReachable(id, vo1.first)){
-                    SituationInstance& cInstance = se->getInstance(vo1.first);
+            for(auto cause : sg->getImplicitCauses(index)){
+                auto vo1 = topMap.find(sg->nodes[cause].id);
+                if(vo1 != topMap.end()){
+                    SituationInstance& cInstance = se->getInstanceAt(cause);
                     /*
                      * check whether causes have been triggered in the last time slice
                      */
                     if(cInstance.counter == instance.counter){
-                        newVoMap[vo1.first] = vo1.second;
+                        newVoMap[vo1->first] = vo1->second;
                         sameSlice = true;
                         hasCause = true;
-//                        cout << "find cause situation (" << vo.second << ")'s cause (" << vo1.second << endl;
+//                        cout << "find cause situation (" << vo.second << ")'s cause (" << vo1->second << endl;
                     }
                 }
             }
@@ -131,7 +136,7 @@ queue<vector<VirtualOperation>> OperationGenerator::generateOperations(set<long>
                 topMap.erase(vo.first);
             }
 
-            cout << "migrate operation set" << endl;
+            LOG_DEBUG("migrate operation set");
         }
 
     }while(hasCause);
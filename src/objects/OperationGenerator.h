@@ -17,6 +17,7 @@
 #define OBJECTS_OPERATIONGENERATOR_H_
 
 #include <vector>
+#include <memory>
 #include <queue>
 #include "SituationGraph.h"
 #include "SituationEvolution.h"
@@ -25,15 +26,16 @@
 
 class OperationGenerator {
 private:
-    SituationGraph sg;
+    // shared with the situation evolution
+    std::shared_ptr<const SituationGraph> sg;
     SituationEvolution* se;
     map<long, vector<OperationalEvent>> eventQueues;
 public:
     OperationGenerator();
-    void setModel(SituationGraph sg);
+    void setModel(std::shared_ptr<const SituationGraph> sg);
     void setModelInstance(SituationEvolution* se);
     void cacheEvent(long eventId, bool toTrigger, simtime_t timestamp);
-    queue<vector<VirtualOperation>> generateOperations(set<long> cycleTriggered);
+    queue<vector<VirtualOperation>> generateOperations(const vector<long> &cycleTriggered);
     virtual ~OperationGenerator();
 };
 
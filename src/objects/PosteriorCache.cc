@@ -0,0 +1,98 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "PosteriorCache.h"
+
+PosteriorCache::PosteriorCache() {
+    capacity = 0;
+    hits = 0;
+    misses = 0;
+}
+
+PosteriorCache::~PosteriorCache() {
+    // TODO Auto-generated destructor stub
+}
+
+uint64_t PosteriorCache::_hash(const vector<long> &signature) {
+    // FNV-1a over the numbers, each mixed by the splitmix64 finalizer
+    uint64_t h = 14695981039346656037ULL;
+    for (long x : signature) {
+        uint64_t z = (uint64_t) x + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z ^= z >> 31;
+        h = (h ^ z) * 1099511628211ULL;
+    }
+    return h;
+}
+
+void PosteriorCache::setCapacity(size_t capacity) {
+    this->capacity = capacity;
+    while (entries.size() > capacity) {
+        index.erase(entries.back().hash);
+        entries.pop_back();
+    }
+}
+
+bool PosteriorCache::isEnabled() {
+    return capacity > 0;
+}
+
+bool PosteriorCache::lookup(const vector<long> &signature,
+        vector<double> &probabilities, double &error) {
+    auto it = index.find(_hash(signature));
+    if (it == index.end() || it->second->signature != signature) {
+        misses++;
+        return false;
+    }
+    // move to the front as the most recently used
+    entries.splice(entries.begin(), entries, it->second);
+    probabilities = it->second->probabilities;
+    error = it->second->error;
+    hits++;
+    return true;
+}
+
+void PosteriorCache::insert(const vector<long> &signature,
+        const vector<double> &probabilities, double error) {
+    if (capacity == 0) {
+        return;
+    }
+    uint64_t hash = _hash(signature);
+    auto it = index.find(hash);
+    if (it != index.end()) {
+        // a colliding signature is replaced
+        entries.erase(it->second);
+        index.erase(it);
+    } else if (entries.size() >= capacity) {
+        index.erase(entries.back().hash);
+        entries.pop_back();
+    }
+    entries.push_front(Entry { hash, signature, probabilities, error });
+    index[hash] = entries.begin();
+}
+
+void PosteriorCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+long PosteriorCache::numOfHits() {
+    return hits;
+}
+
+long PosteriorCache::numOfMisses() {
+    return misses;
+}
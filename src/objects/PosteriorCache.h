@@ -0,0 +1,64 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_POSTERIORCACHE_H_
+#define OBJECTS_POSTERIORCACHE_H_
+
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+ * Bounded LRU cache of posterior probabilities, keyed by an evidence signature.
+ * A signature is any sequence of numbers that determines the posteriors, e.g., the
+ * queries followed by the pruned evidence assignment. Entries are found by a 64-bit
+ * hash of the signature, and the full signature is compared to rule out collisions.
+ */
+class PosteriorCache {
+private:
+    struct Entry {
+        uint64_t hash;
+        vector<long> signature;
+        vector<double> probabilities;
+        double error;
+    };
+    // 0 disables the cache
+    size_t capacity;
+    // most recently used first
+    list<Entry> entries;
+    unordered_map<uint64_t, list<Entry>::iterator> index;
+    long hits;
+    long misses;
+
+    static uint64_t _hash(const vector<long> &signature);
+public:
+    PosteriorCache();
+    void setCapacity(size_t capacity);
+    bool isEnabled();
+    // return whether signature is cached, in which case probabilities and error are set
+    bool lookup(const vector<long> &signature, vector<double> &probabilities,
+            double &error);
+    void insert(const vector<long> &signature,
+            const vector<double> &probabilities, double error);
+    void clear();
+    long numOfHits();
+    long numOfMisses();
+    virtual ~PosteriorCache();
+};
+
+#endif /* OBJECTS_POSTERIORCACHE_H_ */
@@ -0,0 +1,179 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <algorithm>
+#include "ReachabilityIndex.h"
+
+ReachabilityIndex::ReachabilityIndex() {
+    size = 0;
+    words = 0;
+}
+
+void ReachabilityIndex::build(int n, const vector<pair<int, int>> &edges) {
+    size = n;
+    words = (n + 63) / 64;
+
+    /*
+     * 1. Build a CSR adjacency over vertex indices
+     */
+    vector<int> offsets(n + 1, 0);
+    for (auto &edge : edges) {
+        if (edge.first != edge.second) {
+            offsets[edge.first + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    vector<int> targets(offsets[n]);
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (auto &edge : edges) {
+        if (edge.first != edge.second) {
+            targets[fill[edge.first]++] = edge.second;
+        }
+    }
+
+    /*
+     * 2. Condense strongly connected components
+     */
+    _condense(offsets, targets);
+    int numOfComponents = cyclic.size();
+
+    vector<vector<int>> members(numOfComponents);
+    for (int v = 0; v < n; v++) {
+        members[component[v]].push_back(v);
+    }
+
+    /*
+     * 3. Compute the closure row of each component. Tarjan emits components in
+     * reverse topological order, so all successor rows are final when a row is built.
+     */
+    closure.assign((size_t) numOfComponents * words, 0);
+    // the last component whose row has been merged into, to skip duplicate edges
+    vector<int> merged(numOfComponents, -1);
+    for (int c = 0; c < numOfComponents; c++) {
+        uint64_t *row = &closure[(size_t) c * words];
+        for (auto v : members[c]) {
+            row[v >> 6] |= (uint64_t) 1 << (v & 63);
+        }
+        merged[c] = c;
+        for (auto u : members[c]) {
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                int s = component[targets[e]];
+                if (merged[s] == c) {
+                    continue;
+                }
+                merged[s] = c;
+                const uint64_t *succ = &closure[(size_t) s * words];
+                for (int w = 0; w < words; w++) {
+                    row[w] |= succ[w];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Iterative Tarjan's algorithm, which avoids deep recursion on long cause chains
+ */
+void ReachabilityIndex::_condense(const vector<int> &offsets,
+        const vector<int> &targets) {
+    const int UNVISITED = -1;
+    vector<int> order(size, UNVISITED);
+    vector<int> low(size, 0);
+    vector<char> onStack(size, 0);
+    vector<int> st;
+    // DFS frames of <vertex, next edge>
+    vector<pair<int, int>> frames;
+    int counter = 0;
+
+    component.assign(size, -1);
+    cyclic.clear();
+
+    for (int root = 0; root < size; root++) {
+        if (order[root] != UNVISITED) {
+            continue;
+        }
+        frames.push_back(make_pair(root, offsets[root]));
+        order[root] = low[root] = counter++;
+        st.push_back(root);
+        onStack[root] = 1;
+
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            int &e = frames.back().second;
+            if (e < offsets[v + 1]) {
+                int w = targets[e++];
+                if (order[w] == UNVISITED) {
+                    order[w] = low[w] = counter++;
+                    st.push_back(w);
+                    onStack[w] = 1;
+                    frames.push_back(make_pair(w, offsets[w]));
+                } else if (onStack[w]) {
+                    low[v] = min(low[v], order[w]);
+                }
+                continue;
+            }
+
+            // all edges of v are explored
+            frames.pop_back();
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                low[parent] = min(low[parent], low[v]);
+            }
+            if (low[v] == order[v]) {
+                int c = cyclic.size();
+                int count = 0;
+                int w;
+                do {
+                    w = st.back();
+                    st.pop_back();
+                    onStack[w] = 0;
+                    component[w] = c;
+                    count++;
+                } while (w != v);
+                cyclic.push_back(count > 1);
+            }
+        }
+    }
+}
+
+bool ReachabilityIndex::reachable(int src, int dest) const {
+    int c = component[src];
+    if (src == dest) {
+        return cyclic[c];
+    }
+    return (closure[(size_t) c * words + (dest >> 6)] >> (dest & 63)) & 1;
+}
+
+const uint64_t* ReachabilityIndex::row(int src) const {
+    return &closure[(size_t) component[src] * words];
+}
+
+int ReachabilityIndex::numOfWords() const {
+    return words;
+}
+
+bool ReachabilityIndex::sameComponent(int u, int v) const {
+    return component[u] == component[v];
+}
+
+int ReachabilityIndex::numOfVertices() const {
+    return size;
+}
+
+ReachabilityIndex::~ReachabilityIndex() {
+    // TODO Auto-generated destructor stub
+}
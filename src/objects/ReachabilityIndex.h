@@ -0,0 +1,67 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_REACHABILITYINDEX_H_
+#define OBJECTS_REACHABILITYINDEX_H_
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+/*
+ * Transitive closure of a directed graph over dense vertex indices [0, n).
+ *
+ * Strongly connected components are condensed first (Tarjan), and the closure
+ * is then computed Purdom-style: components are visited in reverse topological
+ * order and each component row is the word-wise OR of its successor rows. Rows
+ * are packed into 64-bit words and stored contiguously, so the OR loop is a
+ * plain vectorizable loop and the cost is O(n * m / 64) instead of O(n^4).
+ */
+class ReachabilityIndex {
+    // restores the closure from a precompiled model image
+    friend class ModelImage;
+private:
+    int size;
+    // number of 64-bit words per row
+    int words;
+    // vertex index -> component index
+    vector<int> component;
+    // whether a component lies on a cycle, i.e., its vertices reach themselves
+    vector<char> cyclic;
+    // one packed row per component, reflexive over the component members
+    vector<uint64_t> closure;
+
+    void _condense(const vector<int> &offsets, const vector<int> &targets);
+public:
+    ReachabilityIndex();
+    // edges are <src, dest> pairs of vertex indices; self-loops are ignored
+    void build(int n, const vector<pair<int, int>> &edges);
+    // whether dest can be reached from src through at least one edge
+    bool reachable(int src, int dest) const;
+    /*
+     * Packed row of the vertices reachable from src, numOfWords() words long, which also
+     * has the bits of the component of src set
+     */
+    const uint64_t* row(int src) const;
+    int numOfWords() const;
+    // whether u and v reach each other, or are the same vertex
+    bool sameComponent(int u, int v) const;
+    int numOfVertices() const;
+    virtual ~ReachabilityIndex();
+};
+
+#endif /* OBJECTS_REACHABILITYINDEX_H_ */
@@ -13,6 +13,7 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include "../common/Logger.h"
 #include "../common/RandomClass.h"
 #include "../common/Util.h"
 #include "SituationArranger.h"
@@ -24,7 +25,7 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
 
     set<long> causes;
 
-    cout << endl << "current time in Arranger: " << current << endl;
+    LOG_DEBUG("\ncurrent time in Arranger: " << current);
 
     vector<PhysicalOperation> operations;
 
@@ -32,12 +33,9 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
      * 1. Build a list of triggerable top-layer situations: A top-down approach to generate situations
      */
     set<long> triggerables;
-    DirectedGraph top = sg.getLayer(0);
-    vector<long> topNodes = top.topo_sort();
-
-    for (auto node : topNodes) {
-        SituationNode s = sg.getNode(node);
-        SituationInstance &si = instanceMap[node];
+    for (auto i : sg->getLayerOrder(0)) {
+        const SituationNode &s = sg->nodes[i];
+        SituationInstance &si = instances[i];
         if(si.counter < max_trigger_limit){
             if (s.causes.empty()) {
                         triggerables.insert(si.id);
@@ -45,7 +43,7 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
                         // a top-layer situation is to be triggered only if its trigger count is less than all causes
                         bool toTrigger = true;
                         for (auto cause : s.causes) {
-                            SituationInstance cs = instanceMap[cause];
+                            const SituationInstance &cs = instances[cause];
                             if (cs.counter <= si.counter) {
                                 toTrigger = false;
                                 break;
@@ -64,7 +62,7 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
     for (auto triggerable : triggerables) {
 
         // ti: top-layer instance
-        SituationInstance &ti = instanceMap[triggerable];
+        SituationInstance &ti = getInstance(triggerable);
 
         if (ti.state == SituationInstance::UNTRIGGERED) {
             if (ti.next_start <= current && Random.NextDecimal() > 0) {
@@ -75,10 +73,10 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
                 ti.state = SituationInstance::TRIGGERING;
 
                 // trigger all related bottom-layer situations
-                vector<long> tBottoms = sg.getOperationalSitutions(triggerable);
+                vector<long> tBottoms = sg->getOperationalSitutions(triggerable);
                 for (auto tBottom : tBottoms) {
                     // bottom instance
-                    SituationInstance &bi = instanceMap[tBottom];
+                    SituationInstance &bi = getInstance(tBottom);
                     bi.state = SituationInstance::TRIGGERING;
                     tOpStiuations.insert(tBottom);
                 }
@@ -96,10 +94,10 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
              * to untriggered.
              */
             bool allTriggered = true;
-            vector<long> tBottoms = sg.getOperationalSitutions(triggerable);
+            vector<long> tBottoms = sg->getOperationalSitutions(triggerable);
             for (auto tBottom : tBottoms) {
                 // bi: bottom-layer instance
-                SituationInstance &bi = instanceMap[tBottom];
+                SituationInstance &bi = getInstance(tBottom);
                 if (bi.state == SituationInstance::TRIGGERING
                         || bi.counter <= ti.counter) {
                     allTriggered = false;
@@ -126,9 +124,9 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
                  * Leave the top-layer situation triggered and its bottom-layer evidences triggerable,
                  * if some bottom-layer evidence has not been triggered
                  */
-                vector<long> tBottoms = sg.getOperationalSitutions(triggerable);
+                vector<long> tBottoms = sg->getOperationalSitutions(triggerable);
                 for (auto tBottom : tBottoms) {
-                    SituationInstance &bi = instanceMap[tBottom];
+                    SituationInstance &bi = getInstance(tBottom);
                     // leave the bottom-layer evidence triggered
                     if (bi.state == SituationInstance::UNTRIGGERED
                             && bi.counter <= ti.counter) {
@@ -146,9 +144,8 @@ vector<PhysicalOperation> SituationArranger::arrange(int max_trigger_limit, simt
     /*
      * 3. Pick triggerable operational situations if their triggering cycle has been reached and they are observable
      */
-    vector<long> bottoms = sg.getAllOperationalSitutions();
-    for (auto bottom : bottoms) {
-        SituationInstance &bi = instanceMap[bottom];
+    for (auto i : sg->getLayerOrder(sg->modelHeight() - 1)) {
+        SituationInstance &bi = instances[i];
 
         // cycle match check
         simtime_t value = fmod(current, bi.cycle);
@@ -13,6 +13,7 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include "../common/Logger.h"
 #include "SituationEvolution.h"
 
 SituationEvolution::SituationEvolution() {
@@ -24,27 +25,41 @@ SituationEvolution::~SituationEvolution() {
 }
 
 void SituationEvolution::initModel(const char *model_path) {
-    sg.loadModel(model_path, this);
+    sg = ModelRegistry::load(model_path);
+    instances.clear();
+    for (auto &node : sg->nodes) {
+        addInstance(node.id, node.type, node.duration, node.cycle);
+    }
 }
 
 void SituationEvolution::addInstance(long id, SituationInstance::Type type,
         simtime_t duration, simtime_t cycle) {
     SituationInstance si(id, type, duration, cycle);
-    instanceMap[si.id] = si;
+    // the situation has been indexed by the graph before its instance is added
+    int index = sg->indexOf(id);
+    if (index < 0) {
+        throw cRuntimeError("Instance of an unknown situation %ld", id);
+    }
+    if (index >= (int) instances.size()) {
+        instances.resize(index + 1);
+    }
+    instances[index] = si;
 }
 
 int SituationEvolution::numOfConsistentOperation(){
     int consistency = 0;
-    vector<long> operations = sg.getAllOperationalSitutions();
+    const vector<long> &operations = sg->getAllOperationalSitutions();
     for(auto op : operations){
+        int index = sg->indexOf(op);
+        const SituationInstance &instance = instances[index];
         bool inconsistency = false;
         /*
          * Check the explicit cause only
          */
-//        vector<long> causes = sg.getNode(op).causes;
+//        vector<long> causes = sg->getNode(op).causes;
 //        for(auto cause : causes){
-//            int causeCounter = instanceMap[cause].counter;
-//            if(causeCounter < instanceMap[op].counter){
+//            int causeCounter = getInstance(cause).counter;
+//            if(causeCounter < getInstance(op).counter){
 //                inconsistency = true;
 //                break;
 //            }
@@ -52,18 +67,16 @@ int SituationEvolution::numOfConsistentOperation(){
         /*
          * Check both explicit cause and implicit cause
          */
-        for(auto op2 : operations){
-            if(op2 != op && sg.isReachable(op2, op) && !sg.isReachable(op, op2)){
-                int causeCounter = instanceMap[op2].counter;
-                if(causeCounter < instanceMap[op].counter){
+        for(auto op2 : sg->getImplicitCauses(index)){
+            int causeCounter = instances[op2].counter;
+            if(causeCounter < instance.counter){
 
-//                    cout << "cause " << op2 << " counter " << causeCounter
-//                            << " less than situation " << op << " counter "
-//                            << instanceMap[op].counter << endl;
+//                cout << "cause " << op2 << " counter " << causeCounter
+//                        << " less than situation " << op << " counter "
+//                        << getInstance(op).counter << endl;
 
-                    inconsistency = true;
-                    break;
-                }
+                inconsistency = true;
+                break;
             }
         }
 
@@ -75,15 +88,28 @@ int SituationEvolution::numOfConsistentOperation(){
 }
 
 SituationInstance& SituationEvolution::getInstance(long id) {
-    return instanceMap[id];
+    int index = sg->indexOf(id);
+    if (index < 0) {
+        throw cRuntimeError("Instance of an unknown situation %ld", id);
+    }
+    return instances[index];
+}
+
+SituationInstance& SituationEvolution::getInstanceAt(int index) {
+    return instances[index];
+}
+
+const SituationGraph& SituationEvolution::getModel() {
+    return *sg;
 }
 
-SituationGraph& SituationEvolution::getModel() {
+std::shared_ptr<const SituationGraph> SituationEvolution::getModelHandle() {
     return sg;
 }
 
 void SituationEvolution::print() {
-    for (auto m : instanceMap) {
-        cout << m.second;
+    Logger::Record record;
+    for (auto &instance : instances) {
+        record.stream() << instance;
     }
 }
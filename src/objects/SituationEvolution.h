@@ -18,30 +18,38 @@
 
 #include <omnetpp.h>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include "SituationInstance.h"
 #include "PhysicalOperation.h"
 #include "SituationGraph.h"
+#include "ModelRegistry.h"
 
 using namespace omnetpp;
 using namespace std;
 
 class SituationEvolution {
 protected:
-    SituationGraph sg;
-    map<int, SituationInstance> instanceMap;
+    // shared with every module using the same model file
+    std::shared_ptr<const SituationGraph> sg;
+    // situation instances stored densely, indexed by SituationNode::index
+    vector<SituationInstance> instances;
 public:
     SituationEvolution();
-    void initModel(const char *model_path);
+    virtual void initModel(const char *model_path);
     // return a list of operations as operational situations
     void addInstance(long id, SituationInstance::Type type =
             SituationInstance::NORMAL, simtime_t duration = 0, simtime_t cycle =
             0);
     // An consistent operation is a triggered operation one that its cause has already been triggered
     int numOfConsistentOperation();
+    // map-style access by situation ID
     SituationInstance& getInstance(long id);
-    SituationGraph& getModel();
+    // direct access by SituationNode::index
+    SituationInstance& getInstanceAt(int index);
+    const SituationGraph& getModel();
+    std::shared_ptr<const SituationGraph> getModelHandle();
     void print();
     virtual ~SituationEvolution();
 };
@@ -15,36 +15,34 @@
 
 #include <omnetpp.h>
 #include <stack>
-#include "SituationEvolution.h"
+#include <algorithm>
+#include "../common/Logger.h"
 #include "SituationGraph.h"
+#include "ModelParser.h"
 
 SituationGraph::SituationGraph() {
     // TODO Auto-generated constructor stub
 }
 
-vector<long> SituationGraph::getAllOperationalSitutions() {
-    vector<long> operational_situations;
-    DirectedGraph &bottom = layers[layers.size() - 1];
-    vector<long> bottom_nodes = bottom.topo_sort();
-    for (auto node : bottom_nodes) {
-        SituationNode &operational_situation = situationMap[node];
-        operational_situations.push_back(operational_situation.id);
-    }
-    return operational_situations;
+const vector<long>& SituationGraph::getAllOperationalSitutions() const {
+    return layers[layers.size() - 1].topo_sort();
 }
 
-vector<long> SituationGraph::getOperationalSitutions(long topNodeId) {
+vector<long> SituationGraph::getOperationalSitutions(long topNodeId) const {
     vector<long> operational_situations;
 
-    SituationNode &topNode = situationMap[topNodeId];
-    stack<SituationNode> toChecks;
-    toChecks.push(topNode);
+    // situation indices to check
+    stack<int> toChecks;
+    int top = indexOf(topNodeId);
+    if (top < 0) {
+        throw cRuntimeError("Unknown situation %ld", topNodeId);
+    }
+    toChecks.push(top);
     while (!toChecks.empty()) {
-        SituationNode toCheck = toChecks.top();
+        const SituationNode &toCheck = nodes[toChecks.top()];
         toChecks.pop();
         if (!toCheck.evidences.empty()) {
-            for (auto evidenceId : toCheck.evidences) {
-                SituationNode evidence = situationMap[evidenceId];
+            for (auto evidence : toCheck.evidences) {
                 toChecks.push(evidence);
             }
         } else {
@@ -55,264 +53,193 @@ vector<long> SituationGraph::getOperationalSitutions(long topNodeId) {
     return operational_situations;
 }
 
-bool SituationGraph::isReachable(long src, long dest) {
-    int i = situationMap[src].index;
-    int j = situationMap[dest].index;
-    return ri->at(i)[j];
+int SituationGraph::indexOf(long id) const {
+    auto it = indexMap.find(id);
+    if (it == indexMap.end()) {
+        return -1;
+    }
+    return it->second;
 }
 
-/*
- * For square matrix only
- */
-vector<vector<bool>> SituationGraph::_boolMatrixPower(vector<vector<bool>> &mat,
-        int n) {
-    vector<vector<bool>> mat_n = mat;
-    int k = mat_n.size();
+bool SituationGraph::isReachable(long src, long dest) const {
+    int i = indexOf(src);
+    int j = indexOf(dest);
+    if (i < 0 || j < 0) {
+        return false;
+    }
+    return ri.reachable(i, j);
+}
 
-    for (int pow = 0; pow < n - 1; pow++) {
-        vector<vector<bool>> temp = mat_n;
-        for (int i = 0; i < k; i++) {
-            for (int j = 0; j < k; j++) {
-                bool value = false;
-                for (int m = 0; m < k; m++) {
-                    value = value || (temp[i][m] && mat[m][j]);
-                    if (value)
-                        // early out
-                        break;
-                }
-                mat_n[i][j] = value;
-            }
+void SituationGraph::_buildLayerOrders() {
+    layerOrders.assign(layers.size(), vector<int>());
+    for (size_t l = 0; l < layers.size(); l++) {
+        const vector<long> &order = layers[l].topo_sort();
+        layerOrders[l].reserve(order.size());
+        for (auto id : order) {
+            layerOrders[l].push_back(indexOf(id));
         }
     }
-
-    return mat_n;
 }
 
-/*
- * For square matrix only
- */
-void SituationGraph::_boolMatrixAdd(vector<vector<bool>> *result,
-        vector<vector<bool>> &mat1, vector<vector<bool>> &mat2) {
-    int n = mat1.size();
-
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            result->at(i)[j] = mat1[i][j] || mat2[i][j];
+void SituationGraph::_buildReachabilityMatrix() {
+    /*
+     * map situation edges to vertex indices: cause edges are read from the CSR form of
+     * the layers, and evidence edges go both ways
+     */
+    vector<pair<int, int>> indexEdges;
+    for (auto &graph : layers) {
+        int n = graph.num_vertices();
+        vector<int> indices(n);
+        for (int i = 0; i < n; i++) {
+            indices[i] = indexOf(graph.vertex(i));
+        }
+        for (int i = 0; i < n; i++) {
+            for (auto j : graph.successors(i)) {
+                indexEdges.push_back(make_pair(indices[i], indices[j]));
+            }
+        }
+    }
+    for (auto &node : nodes) {
+        for (auto evidence : node.evidences) {
+            indexEdges.push_back(make_pair(evidence, node.index));
+            indexEdges.push_back(make_pair(node.index, evidence));
         }
     }
+
+    /*
+     * build reachability index
+     */
+    ri.build(nodes.size(), indexEdges);
 }
 
-void SituationGraph::_buildReachabilityMatrix(set<long> &vertices,
-        set<edge_id> &edges) {
+void SituationGraph::_buildImplicitCauses() {
+    implicitCauses.assign(nodes.size(), vector<int>());
+
     /*
-     * initialize reachability matrix
+     * Operational situations in ascending order of ID, and their bits in a row of the
+     * reachability index
      */
-    int size = vertices.size();
-    ri = new vector<vector<bool>>(size, vector<bool>(size, false));
+    const vector<long> &operations = getAllOperationalSitutions();
+    vector<int> bottoms;
+    bottoms.reserve(operations.size());
+    int words = ri.numOfWords();
+    vector<uint64_t> mask(words, 0);
+    for (auto op : operations) {
+        int i = indexOf(op);
+        bottoms.push_back(i);
+        mask[i >> 6] |= 1ULL << (i & 63);
+    }
+    sort(bottoms.begin(), bottoms.end(), [this](int a, int b) {
+        return nodes[a].id < nodes[b].id;
+    });
 
     /*
-     * build adjacency matrix
+     * op2 strictly precedes op if op is in the row of op2 and they are not in the same
+     * component, as situations reaching each other are. Visiting op2 in ascending order
+     * of ID keeps every cause list sorted by ID.
      */
-    vector<vector<bool>> adjMatrix(size, vector<bool>(size, false));
-    for (auto src : vertices) {
-        for (auto dest : vertices) {
-            if (src != dest) {
-                edge_id eid;
-                eid.first = src;
-                eid.second = dest;
-                if (edges.count(eid)) {
-                    int i = situationMap[src].index;
-                    int j = situationMap[dest].index;
-                    adjMatrix[i][j] = true;
+    for (auto i : bottoms) {
+        const uint64_t *row = ri.row(i);
+        for (int w = 0; w < words; w++) {
+            uint64_t bits = row[w] & mask[w];
+            while (bits) {
+                int j = (w << 6) + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                if (!ri.sameComponent(i, j)) {
+                    implicitCauses[j].push_back(i);
                 }
             }
         }
     }
+}
 
-    /*
-     * build reachability matrix
-     */
-    for (int i = 1; i <= size; i++) {
-        vector<vector<bool>> adjMatrixPow = _boolMatrixPower(adjMatrix, i);
-        vector<vector<bool>> temp = *ri;
-        _boolMatrixAdd(ri, temp, adjMatrixPow);
-    }
+const vector<int>& SituationGraph::getImplicitCauses(int index) const {
+    return implicitCauses[index];
 }
 
-void SituationGraph::loadModel(const std::string &filename,
-        SituationEvolution *se) {
+void SituationGraph::loadModel(const std::string &filename) {
     std::ifstream f(filename);
-    json data = json::parse(f);
-
-    int index = 0;
 
     /*
-     * for constructing reachability index
+     * 1. Create situation graph (SG) while streaming the model, without building
+     * its JSON document
      */
-    set<long> vertices;
-    set<edge_id> edges;
+    ModelParser parser(*this);
+    parser.parse(f, filename);
 
     /*
-     * 1. Create situation graph (SG)
+     * 1.3 Resolve causes and evidences to dense indices, and link evidences to the
+     * situations they support. IDs are only kept for input and output from now on,
+     * so causes and evidences must be situations of the model.
      */
-    for (const auto &layer : data["layers"].items()) {
-
-        std::map<long, SituationNode> layerMap;
-
-        /*
-         * 1.1 Construct SG nodes and edges
-         */
-        for (const auto &node : layer.value().items()) {
-
-            SituationNode situation;
-            long id = node.value()["ID"].get<long>();
-            situation.id = id;
-            vertices.insert(id);
-            situation.index = index;
-            index++;
-
-            double duration = node.value()["Duration"].get<double>() / 1000.0;
-            SituationInstance::Type type =
-                    (SituationInstance::Type) node.value()["type"].get<short>();
-            if (!node.value()["Cycle"].is_null()) {
-                // cycle is in millisecond
-                double cycle = node.value()["Cycle"].get<double>() / 1000.0;
-                se->addInstance(id, type, SimTime(duration), SimTime(cycle));
-            } else {
-                se->addInstance(id, type, SimTime(duration));
-            }
-
-            /*
-             * 1.1.1 build cause-consequence relations
-             */
-            if (!node.value()["Predecessors"].empty()
-                    && !node.value()["Predecessors"].is_null()) {
-                for (const auto &pre : node.value()["Predecessors"].items()) {
-                    SituationRelation relation;
-                    long src = pre.value()["ID"].get<long>();
-                    relation.src = src;
-                    relation.dest = situation.id;
-                    situation.causes.push_back(src);
-                    relation.type = SituationRelation::H;
-                    short relationValue = pre.value()["Relation"].get<short>();
-                    switch (relationValue) {
-                    case 1:
-                        relation.relation = SituationRelation::AND;
-                        break;
-                    case 2:
-                        relation.relation = SituationRelation::OR;
-                        break;
-                    default:
-                        relation.relation = SituationRelation::SOLE;
-                    }
-                    relation.weight = pre.value()["Weight-x"].get<double>();
-                    edge_id eid;
-                    eid.first = src;
-                    eid.second = relation.dest;
-                    relationMap[eid] = relation;
-                    edges.insert(eid);
-                }
-            }
-
-            /*
-             * 1.1.2 build parent-child relations
-             */
-            if (!node.value()["Children"].empty()
-                    && !node.value()["Children"].is_null()) {
-                for (const auto &chd : node.value()["Children"].items()) {
-                    SituationRelation relation;
-                    long src = chd.value()["ID"].get<long>();
-                    relation.src = src;
-                    relation.dest = situation.id;
-                    situation.evidences.push_back(
-                            chd.value()["ID"].get<long>());
-                    relation.type = SituationRelation::V;
-                    short relationValue = chd.value()["Relation"].get<short>();
-                    switch (relationValue) {
-                    case 1:
-                        relation.relation = SituationRelation::AND;
-                        break;
-                    case 2:
-                        relation.relation = SituationRelation::OR;
-                        break;
-                    default:
-                        relation.relation = SituationRelation::SOLE;
-                    }
-                    relation.weight = chd.value()["Weight-y"].get<double>();
-                    edge_id eid;
-                    eid.first = src;
-                    eid.second = relation.dest;
-                    relationMap[eid] = relation;
-                    edge_id reid;
-                    reid.first = relation.dest;
-                    reid.second = src;
-                    edges.insert(eid);
-                    edges.insert(reid);
-                }
+    for (auto &node : nodes) {
+        for (auto cause : parser.causeIds[node.index]) {
+            int i = indexOf(cause);
+            if (i < 0) {
+                throw cRuntimeError("Situation %ld of model %s has an unknown cause %ld",
+                        node.id, filename.c_str(), cause);
             }
-
-            layerMap[situation.id] = situation;
+            node.causes.push_back(i);
         }
-
-        /*
-         * 1.2 Construct SG layers
-         */
-        DirectedGraph graph;
-        for (auto m : layerMap) {
-            graph.add_vertex(m.first);
-            SituationNode &node = m.second;
-            for (auto p : node.causes) {
-                graph.add_edge(p, node.id);
+        for (auto evidence : parser.evidenceIds[node.index]) {
+            int i = indexOf(evidence);
+            if (i < 0) {
+                throw cRuntimeError("Situation %ld of model %s has an unknown evidence %ld",
+                        node.id, filename.c_str(), evidence);
             }
+            node.evidences.push_back(i);
+            nodes[i].parents.push_back(node.index);
         }
-//        graph.print();
-        layers.push_back(graph);
-
-        // Create mapping relations
-        situationMap.insert(layerMap.begin(), layerMap.end());
     }
 
+    /*
+     * 1.4 Order the situations of every layer
+     */
+    _buildLayerOrders();
+
     /*
      * 2. Create reachability index
      */
-    _buildReachabilityMatrix(vertices, edges);
-//    cout << "print reachability matrix" << endl;
-//    for(auto row : *ri){
-//        for(auto col : row){
-//            cout << col << "  ";
-//        }
-//        cout << endl;
-//    }
+    _buildReachabilityMatrix();
+
+    /*
+     * 3. Create implicit cause lists of operational situations
+     */
+    _buildImplicitCauses();
 }
 
-DirectedGraph SituationGraph::getLayer(int index) {
+const DirectedGraph& SituationGraph::getLayer(int index) const {
     return layers[index];
 }
 
-SituationNode SituationGraph::getNode(long id) {
-    return situationMap[id];
+const vector<int>& SituationGraph::getLayerOrder(int index) const {
+    return layerOrders[index];
+}
+
+const SituationNode& SituationGraph::getNode(long id) const {
+    int i = indexOf(id);
+    if (i < 0) {
+        throw cRuntimeError("Unknown situation %ld", id);
+    }
+    return nodes[i];
 }
 
-int SituationGraph::modelHeight() {
+int SituationGraph::modelHeight() const {
     return layers.size();
 }
 
-int SituationGraph::numOfNodes() {
-    return situationMap.size();
+int SituationGraph::numOfNodes() const {
+    return nodes.size();
 }
 
 void SituationGraph::print() {
-    for (auto m : situationMap) {
-        cout << m.second;
+    Logger::Record record;
+    for (auto &node : nodes) {
+        record.stream() << node;
     }
 }
 
 SituationGraph::~SituationGraph() {
-    // TODO why cannot release pointer here?
-//    if(ri){
-//        ri->clear();
-//        delete ri;
-//        ri = NULL;
-//    }
+    // TODO Auto-generated destructor stub
 }
 
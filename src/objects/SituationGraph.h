@@ -19,43 +19,69 @@
 #include <vector>
 #include <utility>
 #include <map>
+#include <unordered_map>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include "SituationNode.h"
 #include "SituationRelation.h"
 #include "DirectedGraph.h"
+#include "ReachabilityIndex.h"
 
 using namespace std;
 using json = nlohmann::json;
 
-// forward declaration
-class SituationEvolution;
-
 class SituationGraph {
+    // restores the graph from a precompiled model image
+    friend class ModelImage;
 private:
     // reachability index
-    vector<vector<bool>> *ri;
+    ReachabilityIndex ri;
+    // strict implicit causes of each operational situation as dense indices, sorted by
+    // situation ID and indexed by SituationNode::index
+    vector<vector<int>> implicitCauses;
+    // vertices of each layer graph as dense indices, in topological order
+    vector<vector<int>> layerOrders;
 public:
-    map<long, SituationNode> situationMap;
+    // situation nodes stored densely, indexed by SituationNode::index
+    vector<SituationNode> nodes;
+    // situation ID -> SituationNode::index
+    unordered_map<long, int> indexMap;
     typedef pair<long, long> edge_id;
     map<edge_id, SituationRelation> relationMap;
     // For a n-layer SG graph, layers[n-1] is the bottom layer and layers[0] is the top layer
     vector<DirectedGraph> layers;
 private:
-    vector<vector<bool>> _boolMatrixPower(vector<vector<bool>> &mat, int n);
-    void _boolMatrixAdd(vector<vector<bool>> *result,
-            vector<vector<bool>> &mat1, vector<vector<bool>> &mat2);
-    void _buildReachabilityMatrix(set<long> &vertices, set<edge_id> &edges);
+    void _buildLayerOrders();
+    void _buildReachabilityMatrix();
+    void _buildImplicitCauses();
 public:
     SituationGraph();
-    vector<long> getAllOperationalSitutions();
-    vector<long> getOperationalSitutions(long topNodeId);
-    bool isReachable(long src, long dest);
-    void loadModel(const std::string &filename, SituationEvolution *arrangeer);
-    DirectedGraph getLayer(int index);
-    int modelHeight();
-    SituationNode getNode(long id);
-    int numOfNodes();
+    /*
+     * Read-only views: the graph is not modified after loading, so accessors return
+     * references into it instead of copies
+     */
+    // operational situations, i.e., the bottom layer in topological order
+    const vector<long>& getAllOperationalSitutions() const;
+    vector<long> getOperationalSitutions(long topNodeId) const;
+    // return the dense index of a situation, or -1 if the situation is unknown
+    int indexOf(long id) const;
+    bool isReachable(long src, long dest) const;
+    /*
+     * Operational situations that strictly precede the operational situation at the given
+     * dense index, i.e., they can reach it but cannot be reached from it.
+     */
+    const vector<int>& getImplicitCauses(int index) const;
+    void loadModel(const std::string &filename);
+    const DirectedGraph& getLayer(int index) const;
+    /*
+     * Dense indices of the vertices of a layer graph in topological order, the same
+     * vertices as getLayer(index).topo_sort(). They include the causes a situation of
+     * the layer has in other layers.
+     */
+    const vector<int>& getLayerOrder(int index) const;
+    int modelHeight() const;
+    const SituationNode& getNode(long id) const;
+    int numOfNodes() const;
     void print();
     virtual ~SituationGraph();
 };
@@ -9,7 +9,12 @@
 
 SituationNode::SituationNode() {
     id = -1;
+    index = -1;
+    layer = -1;
     threshold = 0;
+    type = SituationInstance::NORMAL;
+    duration = 0;
+    cycle = 0;
 }
 
 SituationNode::~SituationNode() {
@@ -10,16 +10,26 @@
 
 #include <iostream>
 #include <vector>
+#include "SituationInstance.h"
 using namespace std;
 
 class SituationNode {
 public:
     long id;
-    // index in a directed graph for reachability query
+    // dense index of the situation, shared by node storage, instance storage and the reachability index
     int index;
+    // layer of the situation, 0 being the top layer
+    int layer;
     double threshold;
-    vector<long> causes;
-    vector<long> evidences;
+    // instance attributes of the situation
+    SituationInstance::Type type;
+    simtime_t duration;
+    simtime_t cycle;
+    // causes, evidences and parents as dense indices, resolved once the model is loaded
+    vector<int> causes;
+    vector<int> evidences;
+    // situations having this situation as evidence
+    vector<int> parents;
 public:
     SituationNode();
     virtual ~SituationNode();
@@ -27,12 +37,12 @@ public:
 
 inline std::ostream& operator<<(std::ostream &os, const SituationNode &s) {
     os << "situation (" << s.id << "): threshold " << s.threshold << endl;
-    os << "causes (" << s.causes.size() << "): ";
+    os << "cause indices (" << s.causes.size() << "): ";
     for(auto cause : s.causes){
         os << cause << ", ";
     }
     os << endl;
-    os << "evidences: (" << s.evidences.size() << "): ";
+    os << "evidence indices: (" << s.evidences.size() << "): ";
     for(auto evidence : s.evidences){
             os << evidence << ", ";
     }
@@ -13,6 +13,8 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include <algorithm>
+#include "../common/Logger.h"
 #include "../common/Util.h"
 #include "SituationReasoner.h"
 
@@ -26,87 +28,278 @@ SituationReasoner::~SituationReasoner() {
     // TODO Auto-generated destructor stub
 }
 
-std::set<long> SituationReasoner::reason(std::set<long> triggered,
-        simtime_t current) {
-    std::set<long> tOperational;
+void SituationReasoner::initModel(const char *model_path) {
+    SituationEvolution::initModel(model_path);
+    engine.loadModel(*sg);
 
-    cout << "show triggered: ";
-    util::printSet(triggered);
+    int numOfNodes = sg->numOfNodes();
+    int numOfLayers = sg->modelHeight();
 
-    int numOfLayers = sg.modelHeight();
+    /*
+     * Rank situations in the order a full sweep evaluates them: the trigger propagation
+     * visits the layers above the bottom one bottom-up, each in topological order, and
+     * the undetermined sweep visits all layers top-down, each in reverse topological order
+     */
+    triggerRank.assign(numOfNodes, -1);
+    triggerOrder.clear();
+    unconditioned.clear();
+    for (int l = numOfLayers - 2; l >= 0; l--) {
+        for (auto i : sg->getLayerOrder(l)) {
+            if (sg->nodes[i].layer != l) {
+                continue;
+            }
+            triggerRank[i] = triggerOrder.size();
+            triggerOrder.push_back(i);
+            if (sg->nodes[i].evidences.empty()) {
+                unconditioned.push_back(i);
+            }
+        }
+    }
+    sweepRank.assign(numOfNodes, -1);
+    sweepOrder.clear();
+    for (int l = 0; l < numOfLayers; l++) {
+        const vector<int> &order = sg->getLayerOrder(l);
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            int i = *it;
+            if (sg->nodes[i].layer != l) {
+                continue;
+            }
+            sweepRank[i] = sweepOrder.size();
+            sweepOrder.push_back(i);
+        }
+    }
+
+    /*
+     * Every upper-layer situation is checked in the first slice
+     */
+    toCheck = triggerOrder;
+    active.clear();
+    isActive.assign(numOfNodes, 0);
+    expiries = decltype(expiries)();
+    // the first refinement enters the evidences of all situations
+    changed.clear();
+    isChanged.assign(numOfNodes, 0);
+    for (int i = 0; i < numOfNodes; i++) {
+        _markChanged(i);
+        if (instances[i].state != SituationInstance::UNTRIGGERED) {
+            _activate(i);
+        }
+        if (instances[i].state == SituationInstance::TRIGGERING) {
+            _scheduleExpiry(i);
+        }
+    }
+    queued.assign(numOfNodes, 0);
+}
+
+void SituationReasoner::_activate(int index) {
+    if (!isActive[index]) {
+        isActive[index] = 1;
+        active.push_back(index);
+    }
+}
+
+void SituationReasoner::_setState(int index, SituationInstance::State state) {
+    instances[index].state = state;
+    _markChanged(index);
+}
+
+void SituationReasoner::_markChanged(int index) {
+    if (!isChanged[index]) {
+        isChanged[index] = 1;
+        changed.push_back(index);
+    }
+}
+
+bool SituationReasoner::_isTriggerable(int index) {
+    SituationInstance &instance = instances[index];
+    for (auto evidence : sg->nodes[index].evidences) {
+        SituationInstance &es = instances[evidence];
+        if (es.counter <= instance.counter) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SituationReasoner::_checkParents(int index) {
+    for (auto parent : sg->nodes[index].parents) {
+        if (triggerRank[parent] >= 0) {
+            toCheck.push_back(parent);
+        }
+    }
+}
+
+void SituationReasoner::_scheduleExpiry(int index) {
+    SituationInstance &si = instances[index];
+    expiries.push(std::make_pair(si.next_start + si.duration, index));
+}
+
+void SituationReasoner::setInferenceBackend(
+        BNInferenceEngine::Backend backend) {
+    engine.setBackend(backend);
+}
+
+void SituationReasoner::setInferenceBudget(long maxSamples,
+        double timeBudget) {
+    engine.setSamplingBudget(maxSamples, timeBudget);
+}
+
+void SituationReasoner::setInferenceRNG(cRNG *rng) {
+    engine.setSamplingRNG(rng);
+}
+
+double SituationReasoner::getInferenceError() {
+    return engine.getErrorEstimate();
+}
+
+void SituationReasoner::setInferenceCacheCapacity(size_t capacity) {
+    engine.setCacheCapacity(capacity);
+}
+
+const std::vector<int>& SituationReasoner::getFiredOperations() const {
+    return fired;
+}
+
+long SituationReasoner::numOfInferenceCacheHits() {
+    return engine.numOfCacheHits();
+}
+
+long SituationReasoner::numOfInferenceCacheMisses() {
+    return engine.numOfCacheMisses();
+}
+
+void SituationReasoner::reason(const std::vector<int> &triggered,
+        simtime_t current, std::vector<long> &operational) {
+
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        std::set<long> ids;
+        for (auto i : triggered) {
+            ids.insert(instances[i].id);
+        }
+        Logger::Record record;
+        record.stream() << "show triggered: ";
+        util::printSet(ids, record.stream());
+    }
+
+    int numOfLayers = sg->modelHeight();
 
     /*
      * 1. Trigger bottom layer situations
      */
     // layers[numOfLayers-1] accesses the bottom layer; layers[0] accesses the top layer
-    DirectedGraph g = sg.getLayer(numOfLayers - 1);
-    std::vector<long> bottoms = g.topo_sort();
-    for (auto bottom : bottoms) {
-        SituationInstance &instance = instanceMap[bottom];
-        auto it = triggered.find(bottom);
-        if (it != triggered.end()) {
-            instance.state = SituationInstance::TRIGGERING;
-            instance.counter++;
-            instance.next_start = current;
+    fired.clear();
+    for (auto i : triggered) {
+        if (sg->nodes[i].layer != numOfLayers - 1) {
+            continue;
         }
+        SituationInstance &instance = instances[i];
+        _setState(i, SituationInstance::TRIGGERING);
+        instance.counter++;
+        instance.next_start = current;
+        _activate(i);
+        _scheduleExpiry(i);
+        fired.push_back(i);
+        _checkParents(i);
     }
 
     /*
      * 2. Trigger upper-layer situations: an over-simplified version of the BP process
+     * Only the situations whose evidence counters changed are checked, in the order of
+     * a full bottom-up sweep, so that a situation triggered in this slice can trigger
+     * its parents in the layers above within the same slice
      */
-    for (int i = numOfLayers - 1; i > 0; i--) {
-        // layers[numOfLayers-1] access the bottom layer
-        DirectedGraph g1 = sg.getLayer(i - 1);
-        std::vector<long> uppers = g1.topo_sort();
-        for (auto upper : uppers) {
-            SituationInstance &instance = instanceMap[upper];
-            SituationNode node = sg.getNode(instance.id);
-            bool toTrigger = true;
-            for (auto evidence : node.evidences) {
-                SituationInstance &es = instanceMap[evidence];
-                if (es.counter <= instance.counter) {
-                    toTrigger = false;
-                    break;
+    checks.clear();
+    checks.swap(toCheck);
+    checks.insert(checks.end(), unconditioned.begin(), unconditioned.end());
+    for (auto i : checks) {
+        if (!queued[i]) {
+            queued[i] = 1;
+            schedule.push(triggerRank[i]);
+        }
+    }
+    while (!schedule.empty()) {
+        int rank = schedule.top();
+        schedule.pop();
+        int i = triggerOrder[rank];
+        queued[i] = 0;
+        if (!_isTriggerable(i)) {
+            continue;
+        }
+        SituationInstance &instance = instances[i];
+        _setState(i, SituationInstance::TRIGGERING);
+        instance.counter++;
+        instance.next_start = current;
+        _activate(i);
+        _scheduleExpiry(i);
+        for (auto j : sg->nodes[i].parents) {
+            if (triggerRank[j] > rank) {
+                if (!queued[j]) {
+                    queued[j] = 1;
+                    schedule.push(triggerRank[j]);
                 }
+            } else if (triggerRank[j] >= 0) {
+                // already visited by the sweep, checked in the next slice
+                toCheck.push_back(j);
             }
-            if (toTrigger) {
-                instance.state = SituationInstance::TRIGGERING;
-                instance.counter++;
-                instance.next_start = current;
-            }
+        }
+        // the condition may still hold with the increased counter
+        if (_isTriggerable(i)) {
+            toCheck.push_back(i);
         }
     }
 
     /*
      * 3. Compute UNDETERMINED state
+     * Only TRIGGERING and UNDETERMINED situations propagate to their causes, so the
+     * sweep starts from the active ones and follows the causes marked on the way
      */
     bool needRefinement = false;
-    for (int i = 0; i < sg.modelHeight(); i++) {
-        DirectedGraph g = sg.getLayer(i);
-        std::vector<long> sortedNodes = g.topo_sort();
-        std::reverse(sortedNodes.begin(), sortedNodes.end());
-        for (auto node : sortedNodes) {
-            SituationInstance &si = instanceMap[node];
-            if (si.state == SituationInstance::TRIGGERING
-                    || si.state == SituationInstance::UNDETERMINED) {
-                std::vector<long> causes = sg.getNode(node).causes;
-                for (auto cause : causes) {
-                    SituationInstance &ci = instanceMap[cause];
-                    // use trigger counter to check cause state
-                    if (ci.counter < si.counter) {
-                        ci.state = SituationInstance::UNDETERMINED;
-                        needRefinement = true;
-
-                        cout << "=============" << endl;
-                        cout << "situation " << ci.id << " is undetermined"
-                                << endl;
-                        cout << "=============" << endl;
-                    }else{
-                        // TODO: instance alignment, here is only a partial implementation
-                        if(si.state == SituationInstance::TRIGGERING && ci.state == SituationInstance::UNTRIGGERED){
-                            ci.state = SituationInstance::TRIGGERED;
-                        }
-                    }
+    undetermined.clear();
+    triggeredCauses.clear();
+    size_t numOfActive = 0;
+    for (size_t k = 0; k < active.size(); k++) {
+        int i = active[k];
+        SituationInstance &si = instances[i];
+        if (si.state == SituationInstance::TRIGGERING
+                || si.state == SituationInstance::UNDETERMINED) {
+            active[numOfActive++] = i;
+            queued[i] = 1;
+            schedule.push(sweepRank[i]);
+        } else {
+            isActive[i] = 0;
+        }
+    }
+    active.resize(numOfActive);
+    while (!schedule.empty()) {
+        int rank = schedule.top();
+        schedule.pop();
+        int i = sweepOrder[rank];
+        queued[i] = 0;
+        SituationInstance &si = instances[i];
+        if (si.state != SituationInstance::TRIGGERING
+                && si.state != SituationInstance::UNDETERMINED) {
+            continue;
+        }
+        for (auto j : sg->nodes[i].causes) {
+            SituationInstance &ci = instances[j];
+            // use trigger counter to check cause state
+            if (ci.counter < si.counter) {
+                _setState(j, SituationInstance::UNDETERMINED);
+                needRefinement = true;
+                _activate(j);
+                undetermined.push_back(j);
+                if (sweepRank[j] > rank && !queued[j]) {
+                    queued[j] = 1;
+                    schedule.push(sweepRank[j]);
+                }
+
+                LOG_TRACE("=============\nsituation " << ci.id
+                        << " is undetermined\n=============");
+            }else{
+                // TODO: instance alignment, here is only a partial implementation
+                if(si.state == SituationInstance::TRIGGERING && ci.state == SituationInstance::UNTRIGGERED){
+                    _setState(j, SituationInstance::TRIGGERED);
+                    triggeredCauses.push_back(j);
                 }
             }
         }
@@ -114,23 +307,44 @@ std::set<long> SituationReasoner::reason(std::set<long> triggered,
 
     /*
      * 4. Update refinement
+     * A refined situation that turns out triggering changes the evidence counter of its
+     * parents, which are checked in the next slice
      */
     if(needRefinement){
-        BNInferenceEngine engine;
-        engine.loadModel(sg);
-        engine.reason(sg, instanceMap, current);
+        engine.reason(*sg, instances, changed, undetermined, current);
+        for (auto i : changed) {
+            isChanged[i] = 0;
+        }
+        changed.clear();
+        for (auto i : undetermined) {
+            // refined to TRIGGERING or UNTRIGGERED, which is evidence from now on
+            _markChanged(i);
+            SituationInstance &si = instances[i];
+            if (si.state == SituationInstance::TRIGGERING
+                    && si.next_start == current) {
+                _scheduleExpiry(i);
+                _checkParents(i);
+                if (sg->nodes[i].layer == numOfLayers - 1) {
+                    fired.push_back(i);
+                }
+            }
+        }
     }
 
     /*
      * 5. Get operational situations to return
      */
-    for (auto bottom : bottoms) {
-        SituationInstance &instance = instanceMap[bottom];
+    operational.clear();
+    for (auto i : fired) {
+        SituationInstance &instance = instances[i];
         if (instance.state == SituationInstance::TRIGGERING
                 && instance.next_start == current) {
-            tOperational.insert(instance.id);
+            operational.push_back(instance.id);
         }
     }
+    std::sort(operational.begin(), operational.end());
+    operational.erase(std::unique(operational.begin(), operational.end()),
+            operational.end());
 
     /*
      * 6. reset transient situations, durable situations is cyclically reset from Synchronizer
@@ -140,29 +354,54 @@ std::set<long> SituationReasoner::reason(std::set<long> triggered,
     /*
      * Reset triggered situation to untriggered state
      */
-    for(auto& instance : instanceMap){
-        if(instance.second.state == SituationInstance::TRIGGERED){
-            instance.second.state = SituationInstance::UNTRIGGERED;
+    for (auto i : triggeredCauses) {
+        SituationInstance &instance = instances[i];
+        if(instance.state == SituationInstance::TRIGGERED){
+            _setState(i, SituationInstance::UNTRIGGERED);
         }
     }
 
 //    cout << "print situation graph instance" << endl;
 //    print();
-
-    return tOperational;
 }
 
 void SituationReasoner::checkState(simtime_t current) {
 
 //    cout << "check state at: " << current << endl;
 
-    // reset transient situations
-    for (auto &si : instanceMap) {
-        if (si.second.next_start + si.second.duration <= current
-                && si.second.state == SituationInstance::TRIGGERING) {
-            si.second.state = SituationInstance::UNTRIGGERED;
+    /*
+     * Pop the expired entries, skipping the stale ones
+     */
+    expired.clear();
+    while (!expiries.empty() && expiries.top().first <= current) {
+        simtime_t expiry = expiries.top().first;
+        int i = expiries.top().second;
+        expiries.pop();
+        SituationInstance &si = instances[i];
+        if (si.state == SituationInstance::TRIGGERING
+                && si.next_start + si.duration == expiry) {
+            expired.push_back(i);
+        }
+    }
+
+    // reset transient situations, in index order
+    std::sort(expired.begin(), expired.end());
+    expired.erase(std::unique(expired.begin(), expired.end()), expired.end());
+    for (auto i : expired) {
+        _setState(i, SituationInstance::UNTRIGGERED);
+
+        LOG_TRACE("reset node " << instances[i].id);
+    }
+}
 
-            cout << "reset node " << si.first << endl;
+simtime_t SituationReasoner::nextExpiry() {
+    while (!expiries.empty()) {
+        SituationInstance &si = instances[expiries.top().second];
+        if (si.state == SituationInstance::TRIGGERING
+                && si.next_start + si.duration == expiries.top().first) {
+            return expiries.top().first;
         }
+        expiries.pop();
     }
+    return -1;
 }
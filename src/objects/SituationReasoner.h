@@ -18,6 +18,9 @@
 
 #include <algorithm>
 #include <omnetpp.h>
+#include <queue>
+#include <set>
+#include <vector>
 #include "SituationEvolution.h"
 #include "BNInferenceEngine.h"
 
@@ -26,12 +29,78 @@ using namespace std;
 
 class SituationReasoner: public SituationEvolution {
 private:
+    // built once with the model and reused by every refinement
+    BNInferenceEngine engine;
+    /*
+     * Incremental propagation: a situation is only re-evaluated when one of its inputs
+     * changed, in the same order as a full sweep would evaluate it
+     */
+    // rank of each situation in the trigger propagation (layers above the bottom, bottom-up),
+    // -1 for bottom situations, and the situation index at each rank
+    std::vector<int> triggerRank;
+    std::vector<int> triggerOrder;
+    // rank of each situation in the undetermined sweep (all layers, top-down)
+    std::vector<int> sweepRank;
+    std::vector<int> sweepOrder;
+    // upper-layer situations without evidence, whose trigger condition always holds
+    std::vector<int> unconditioned;
+    // upper-layer situations whose trigger condition may hold in the next slice
+    std::vector<int> toCheck;
+    // situations that may be TRIGGERING or UNDETERMINED, and their membership flags
+    std::vector<int> active;
+    std::vector<char> isActive;
+    // situations whose state changed since the last refinement, and their membership flags
+    std::vector<int> changed;
+    std::vector<char> isChanged;
+    /*
+     * Scratch buffers reused by every slice, so that steady-state reasoning does not
+     * allocate
+     */
+    // flags of scheduled situations
+    std::vector<char> queued;
+    // ranks of the situations to evaluate, lowest first
+    std::priority_queue<int, std::vector<int>, std::greater<int>> schedule;
+    std::vector<int> checks;
+    // bottom situations triggered in the slice
+    std::vector<int> fired;
+    std::vector<int> undetermined;
+    // causes set to TRIGGERED in the slice
+    std::vector<int> triggeredCauses;
+    std::vector<int> expired;
+    // <expiry time, situation index> of TRIGGERING situations, earliest first. An entry
+    // is stale once the situation is no longer TRIGGERING or has been triggered again.
+    typedef std::pair<simtime_t, int> expiry_t;
+    std::priority_queue<expiry_t, std::vector<expiry_t>, std::greater<expiry_t>> expiries;
+    void _scheduleExpiry(int index);
+    void _activate(int index);
+    // set the state of a situation, whose evidence is updated by the next refinement
+    void _setState(int index, SituationInstance::State state);
+    void _markChanged(int index);
+    bool _isTriggerable(int index);
+    void _checkParents(int index);
 public:
     SituationReasoner();
-    // return a set of triggered operational situations
-    std::set<long> reason(std::set<long> triggered, simtime_t current);
+    virtual void initModel(const char *model_path) override;
+    void setInferenceBackend(BNInferenceEngine::Backend backend);
+    // budget of the approximate backend, to be set before selecting it
+    void setInferenceBudget(long maxSamples, double timeBudget);
+    void setInferenceRNG(cRNG *rng);
+    double getInferenceError();
+    // cache of recurring refinements, disabled by default
+    void setInferenceCacheCapacity(size_t capacity);
+    long numOfInferenceCacheHits();
+    long numOfInferenceCacheMisses();
+    // reason from the dense indices of the triggered operational situations, and fill
+    // operational with the IDs of the operational situations to simulate, in ascending order
+    void reason(const std::vector<int> &triggered, simtime_t current,
+            std::vector<long> &operational);
+    // dense indices of the operational situations whose counter the last reasoning
+    // increased, a situation may be listed more than once
+    const std::vector<int>& getFiredOperations() const;
     // reset durable situations if timeout
     void checkState(simtime_t current);
+    // earliest time a TRIGGERING situation expires, -1 if none
+    simtime_t nextExpiry();
     virtual ~SituationReasoner();
 };
 
@@ -0,0 +1,121 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+/*
+ * Allocation benchmark: counts the heap allocations of the reasoning loop, i.e.,
+ * SituationReasoner::reason and checkState, with every inference backend. Each slice
+ * triggers random bottom-layer situations, and only the slices after as many warm-up
+ * slices are counted, so that the reused buffers have reached their sizes.
+ *
+ * usage: allocbench model.json [slices] [triggers per slice]
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <omnetpp.h>
+#include "../src/common/Logger.h"
+#include "../src/objects/SituationReasoner.h"
+
+using namespace omnetpp;
+
+static long allocations = 0;
+static bool counting = false;
+
+void* operator new(size_t size) {
+    if (counting) {
+        allocations++;
+    }
+    void *p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+static const vector<pair<const char*, BNInferenceEngine::Backend>> backends = {
+    { "dlib", BNInferenceEngine::DLIB },
+    { "junctionTree", BNInferenceEngine::JUNCTION_TREE },
+    { "arithmeticCircuit", BNInferenceEngine::ARITHMETIC_CIRCUIT },
+    { "sampling", BNInferenceEngine::LIKELIHOOD_WEIGHTING },
+};
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "usage: allocbench model.json [slices] [triggers per slice]" << endl;
+        return 1;
+    }
+    int slices = argc > 2 ? atoi(argv[2]) : 200;
+    int numOfTriggers = argc > 3 ? atoi(argv[3]) : 3;
+    Logger::setLevel(LOG_LEVEL_WARN);
+
+    for (auto &backend : backends) {
+        try {
+            SituationReasoner sr;
+            sr.initModel(argv[1]);
+            sr.setInferenceBackend(backend.second);
+            const SituationGraph &sg = sr.getModel();
+            const vector<long> &bottoms = sg.getAllOperationalSitutions();
+            // triggered operational situations, and their dense indices in ascending order of ID
+            std::set<long> ids;
+            vector<int> triggered;
+
+            /*
+             * The same triggers for every backend, drawn before the slice is counted
+             */
+            std::mt19937 rng(7);
+            vector<long> operational;
+            long total = 0;
+            allocations = 0;
+            for (int s = 1; s <= 2 * slices; s++) {
+                ids.clear();
+                for (int k = 0; k < numOfTriggers; k++) {
+                    ids.insert(bottoms[rng() % bottoms.size()]);
+                }
+                triggered.clear();
+                for (auto id : ids) {
+                    triggered.push_back(sg.indexOf(id));
+                }
+                simtime_t current = s * 3.0;
+                counting = s > slices;
+                sr.reason(triggered, current, operational);
+                for (int c = 1; c < 6; c++) {
+                    sr.checkState(current + c * 0.5);
+                }
+                counting = false;
+                if (s > slices) {
+                    total += operational.size();
+                }
+            }
+            cout << backend.first << ": " << (double) allocations / slices
+                    << " allocations per slice, " << (double) total / slices
+                    << " operational situations per slice" << endl;
+        } catch (std::exception &e) {
+            counting = false;
+            cout << backend.first << ": skipped, " << e.what() << endl;
+        }
+    }
+    return 0;
+}
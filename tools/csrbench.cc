@@ -0,0 +1,129 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+/*
+ * CSR benchmark: compares successor traversal over the frozen CSR form of a
+ * DirectedGraph with the same traversal over a map of adjacency lists, the form
+ * the graph keeps until it is finalized. The topological orders of frozen and
+ * mutable graphs are checked to be identical first.
+ *
+ * usage: csrbench [vertices]    (default: 200000)
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <map>
+#include <list>
+#include "../src/objects/DirectedGraph.h"
+
+/*
+ * Random layer-like graphs: a frozen graph, also after it is thawed by a mutation,
+ * must sort its vertices exactly like the mutable one
+ */
+static bool check(std::mt19937 &rng) {
+    for (int t = 0; t < 300; t++) {
+        DirectedGraph mutableGraph, frozenGraph;
+        int n = 1 + rng() % 40;
+        int m = rng() % (2 * n);
+        for (int k = 0; k < n; k++) {
+            if (rng() % 2) {
+                long v = 100 + rng() % n;
+                mutableGraph.add_vertex(v);
+                frozenGraph.add_vertex(v);
+            }
+        }
+        for (int k = 0; k < m; k++) {
+            long u = 100 + rng() % n;
+            long v = 100 + rng() % n;
+            if (u < v) {
+                mutableGraph.add_edge(u, v);
+                frozenGraph.add_edge(u, v);
+            }
+        }
+        frozenGraph.finalize();
+        if (mutableGraph.topo_sort() != frozenGraph.topo_sort()
+                || mutableGraph.reverse_topo_sort()
+                        != frozenGraph.reverse_topo_sort()) {
+            cerr << "graph " << t << ": frozen order differs" << endl;
+            return false;
+        }
+        mutableGraph.add_vertex(999);
+        frozenGraph.add_vertex(999);
+        if (mutableGraph.topo_sort() != frozenGraph.topo_sort()) {
+            cerr << "graph " << t << ": thawed order differs" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::mt19937 rng(3);
+    if (!check(rng)) {
+        return 1;
+    }
+    long n = argc > 1 ? atol(argv[1]) : 200000;
+    const int rounds = 20;
+
+    /*
+     * Four causes per vertex, towards lower vertices
+     */
+    map<long, list<long> > adjList;
+    DirectedGraph g;
+    for (long v = 1; v < n; v++) {
+        for (int k = 0; k < 4; k++) {
+            long u = rng() % v;
+            adjList[u].push_back(v);
+            g.add_edge(u, v);
+        }
+    }
+    g.finalize();
+    double edges = 4.0 * (n - 1) * rounds;
+
+    auto start = std::chrono::steady_clock::now();
+    long listSum = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (auto &adj : adjList) {
+            for (auto v : adj.second) {
+                listSum += v;
+            }
+        }
+    }
+    std::chrono::duration<double, std::micro> listTime =
+            std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    long csrSum = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < g.num_vertices(); i++) {
+            for (auto j : g.successors(i)) {
+                csrSum += g.vertex(j);
+            }
+        }
+    }
+    std::chrono::duration<double, std::micro> csrTime =
+            std::chrono::steady_clock::now() - start;
+
+    if (listSum != csrSum) {
+        cerr << "CSR traversal visits other edges than the adjacency lists" << endl;
+        return 1;
+    }
+    cout << n << " vertices: adjacency lists " << edges / listTime.count()
+            << " Medges/s, CSR " << edges / csrTime.count() << " Medges/s" << endl;
+    return 0;
+}
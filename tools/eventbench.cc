@@ -0,0 +1,136 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+/*
+ * IoT event benchmark: throughput of the per-event cause count path between EventSource
+ * and Synchronizer. The packed path fills the causeIndices/causeCounters arrays of an
+ * IoTEvent and decodes them the way the synchronizer does; the JSON path is the one it
+ * replaced, dumping a <situation ID, counter> map to text and parsing it back. Every
+ * operational situation with implicit causes sends one event per round, and both paths
+ * are first checked to deliver the same cause counts.
+ *
+ * usage: eventbench model.json... [-r rounds]    (default: 10000 rounds)
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <omnetpp.h>
+#include <nlohmann/json.hpp>
+#include "../src/messages/IoTEvent_m.h"
+#include "../src/objects/SituationGraph.h"
+
+using namespace omnetpp;
+using json = nlohmann::json;
+
+// cause counts as the synchronizer receives them: <situation ID, counter>, sorted by ID
+typedef vector<pair<long, int>> cause_counts;
+
+static void jsonEvent(const SituationGraph &sg, const vector<int> &counters, long id,
+        cause_counts &received) {
+    map<long, int> causeCounts;
+    for (auto cause : sg.getImplicitCauses(sg.indexOf(id))) {
+        causeCounts[sg.nodes[cause].id] = counters[cause];
+    }
+    std::string wire = json(causeCounts).dump();
+    map<long, int> parsed = json::parse(wire).get<map<long, int>>();
+    received.assign(parsed.begin(), parsed.end());
+}
+
+static void packedEvent(const SituationGraph &sg, const vector<int> &counters, long id,
+        cause_counts &received) {
+    IoTEvent event;
+    const vector<int> &causes = sg.getImplicitCauses(sg.indexOf(id));
+    event.setCauseIndicesArraySize(causes.size());
+    event.setCauseCountersArraySize(causes.size());
+    for (size_t k = 0; k < causes.size(); k++) {
+        event.setCauseIndices(k, causes[k]);
+        event.setCauseCounters(k, counters[causes[k]]);
+    }
+    received.clear();
+    for (size_t k = 0; k < event.getCauseIndicesArraySize(); k++) {
+        received.push_back(make_pair(sg.nodes[event.getCauseIndices(k)].id,
+                event.getCauseCounters(k)));
+    }
+}
+
+int main(int argc, char **argv) {
+    vector<const char*> models;
+    long rounds = 10000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = atol(argv[++i]);
+        } else {
+            models.push_back(argv[i]);
+        }
+    }
+    if (models.empty()) {
+        cerr << "usage: eventbench model.json... [-r rounds]" << endl;
+        return 1;
+    }
+
+    for (auto model : models) {
+        SituationGraph sg;
+        sg.loadModel(model);
+        // arbitrary counters standing in for the situation instances
+        vector<int> counters(sg.numOfNodes());
+        for (size_t i = 0; i < counters.size(); i++) {
+            counters[i] = 1 + i % 7;
+        }
+        vector<long> operational;
+        size_t numOfCauses = 0;
+        for (auto id : sg.getAllOperationalSitutions()) {
+            const vector<int> &causes = sg.getImplicitCauses(sg.indexOf(id));
+            if (!causes.empty()) {
+                operational.push_back(id);
+                numOfCauses += causes.size();
+            }
+        }
+        if (operational.empty()) {
+            cout << model << ": no operational situation with causes" << endl;
+            continue;
+        }
+
+        cause_counts expected, received;
+        for (auto id : operational) {
+            jsonEvent(sg, counters, id, expected);
+            packedEvent(sg, counters, id, received);
+            if (received != expected) {
+                cerr << model << ": the cause counts of situation " << id
+                        << " differ between both paths" << endl;
+                return 1;
+            }
+        }
+
+        cout << model << ": " << operational.size() << " operational situations, "
+                << (double) numOfCauses / operational.size() << " causes per event" << endl;
+        double events = (double) rounds * operational.size();
+        for (int packed = 0; packed < 2; packed++) {
+            auto start = std::chrono::steady_clock::now();
+            for (long r = 0; r < rounds; r++) {
+                for (auto id : operational) {
+                    (packed ? packedEvent : jsonEvent)(sg, counters, id, received);
+                }
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            cout << "  " << (packed ? "packed" : "JSON") << ": "
+                    << (long) (events / elapsed.count()) << " events/s" << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+/*
+ * Inference benchmark: times the inference backends against dlib's join tree on the
+ * networks of situation models and on synthetic networks. Every round observes a third
+ * of the nodes of a state drawn from the network and queries all the other nodes.
+ *
+ * usage: infbench [model.json...]
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <omnetpp.h>
+#include "../src/objects/SituationGraph.h"
+#include "../src/objects/ArithmeticCircuit.h"
+#include "../src/objects/BayesianNetwork.h"
+#include "../src/objects/JunctionTree.h"
+
+using namespace omnetpp;
+
+static const vector<pair<const char*, function<InferenceBackend*()>>> backends = {
+    { "dlib", [] { return new BayesianNetwork(); } },
+    { "arithmeticCircuit", [] { return new ArithmeticCircuit(); } },
+    { "junctionTree", [] { return new JunctionTree(); } },
+};
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * Draw the state of every node from the network, parents first, so that any subset of
+ * the states is a possible evidence
+ */
+static void sample(const vector<FactorizedCPT> &cpts, std::mt19937 &rng,
+        vector<char> &states) {
+    std::uniform_real_distribution<double> uniform(0, 1);
+    states.assign(cpts.size(), -1);
+    vector<long> stack;
+    for (size_t i = 0; i < cpts.size(); i++) {
+        stack.push_back(i);
+        while (!stack.empty()) {
+            long v = stack.back();
+            if (states[v] >= 0) {
+                stack.pop_back();
+                continue;
+            }
+            const FactorizedCPT &cpt = cpts[v];
+            bool ready = true;
+            for (auto parent : cpt.parents) {
+                if (states[parent] < 0) {
+                    stack.push_back(parent);
+                    ready = false;
+                }
+            }
+            if (ready) {
+                double p = cpt.probability([&cpt, &states](int k) {
+                    return states[cpt.parents[k]] == 1;
+                });
+                states[v] = uniform(rng) < p;
+                stack.pop_back();
+            }
+        }
+    }
+}
+
+static void run(const std::string &name, const vector<FactorizedCPT> &cpts) {
+    const int rounds = 20;
+    long n = cpts.size();
+    std::mt19937 rng(1);
+    vector<map<long, long>> evidences(rounds);
+    vector<char> states;
+    for (auto &roundEvidences : evidences) {
+        sample(cpts, rng, states);
+        for (long i = 0; i < n; i++) {
+            if (rng() % 3 == 0) {
+                roundEvidences[i] = states[i];
+            }
+        }
+    }
+
+    for (auto &entry : backends) {
+        InferenceBackend *backend = entry.second();
+        auto start = std::chrono::steady_clock::now();
+        backend->BuildNetwork(n, cpts);
+        double build = millisecondsSince(start);
+
+        double checksum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            backend->buildSolution(evidences[r]);
+            for (long i = 0; i < n; i++) {
+                if (!evidences[r].count(i)) {
+                    checksum += backend->getProbability(i, 1);
+                }
+            }
+        }
+        double round = millisecondsSince(start) / rounds;
+        delete backend;
+        cout << name << " (" << n << " nodes) " << entry.first << ": build " << build
+                << " ms, round " << round << " ms, checksum " << checksum << endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    // default simulation time resolution (picoseconds) for durations and cycles
+    SimTime::setScaleExp(-12);
+
+    /*
+     * 1. The networks of the given models, built like BNInferenceEngine::loadModel
+     */
+    for (int a = 1; a < argc; a++) {
+        SituationGraph sg;
+        sg.loadModel(argv[a]);
+        long n = sg.numOfNodes();
+        vector<FactorizedCPT> cpts(n);
+        for (long i = 0; i < n; i++) {
+            cpts[i].node = i;
+        }
+        for (auto &relation : sg.relationMap) {
+            int src = sg.indexOf(relation.first.first);
+            int dest = sg.indexOf(relation.first.second);
+            if (src >= 0 && dest >= 0) {
+                cpts[dest].addParent(src, relation.second.weight,
+                        relation.second.relation);
+            }
+        }
+        run(argv[a], cpts);
+    }
+
+    /*
+     * 2. Synthetic networks with one to three nearby parents per node
+     */
+    for (long n : { 1000L, 5000L }) {
+        std::mt19937 rng(7);
+        vector<FactorizedCPT> cpts(n);
+        for (long i = 0; i < n; i++) {
+            cpts[i].node = i;
+            int parents = i < 20 ? 0 : 1 + rng() % 3;
+            long nearest = i - 1 - rng() % 4;
+            for (int k = 0; k < parents; k++) {
+                cpts[i].addParent(nearest - k, 0.8,
+                        (SituationRelation::Relation) (rng() % 3));
+            }
+        }
+        run("synthetic", cpts);
+    }
+    return 0;
+}
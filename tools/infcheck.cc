@@ -0,0 +1,141 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+/*
+ * Inference check: compares the posteriors of every inference backend with brute-force
+ * enumeration on small random networks, whose CPTs mix noisy-AND and noisy-OR parents
+ * and exceed FactorizedCPT::MAX_TABLE_PARENTS. Evidences change incrementally between
+ * the solutions of a network, as they do between refinements.
+ *
+ * usage: infcheck [networks]    (default: 300)
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <functional>
+#include "../src/objects/ArithmeticCircuit.h"
+#include "../src/objects/BayesianNetwork.h"
+#include "../src/objects/JunctionTree.h"
+
+// the exact backends, which must agree with enumeration up to rounding
+static const vector<pair<const char*, function<InferenceBackend*()>>> backends = {
+    { "dlib", [] { return new BayesianNetwork(); } },
+    { "arithmeticCircuit", [] { return new ArithmeticCircuit(); } },
+    { "junctionTree", [] { return new JunctionTree(); } },
+};
+
+/*
+ * P(query = 1 | evidences) by summing the joint probability over all 2^n states
+ */
+static double enumerate(const vector<FactorizedCPT> &cpts,
+        const map<long, long> &evidences, long query) {
+    long n = cpts.size();
+    double numerator = 0;
+    double denominator = 0;
+    for (long states = 0; states < (1L << n); states++) {
+        bool consistent = true;
+        for (auto &evidence : evidences) {
+            if (((states >> evidence.first) & 1) != evidence.second) {
+                consistent = false;
+                break;
+            }
+        }
+        if (!consistent) {
+            continue;
+        }
+        double p = 1;
+        for (long i = 0; i < n && p > 0; i++) {
+            const FactorizedCPT &cpt = cpts[i];
+            double p1 = cpt.probability([&cpt, states](int k) {
+                return (states >> cpt.parents[k]) & 1;
+            });
+            p *= ((states >> i) & 1) ? p1 : 1 - p1;
+        }
+        denominator += p;
+        if ((states >> query) & 1) {
+            numerator += p;
+        }
+    }
+    return denominator > 0 ? numerator / denominator : -1;
+}
+
+int main(int argc, char **argv) {
+    int networks = argc > 1 ? atoi(argv[1]) : 300;
+    std::mt19937 rng(42);
+    vector<long> queries(backends.size(), 0);
+    vector<double> maxErrors(backends.size(), 0);
+
+    for (int t = 0; t < networks; t++) {
+        /*
+         * 1. A random network of 3 to 15 nodes, parents towards lower nodes
+         */
+        long n = 3 + rng() % 13;
+        vector<FactorizedCPT> cpts(n);
+        for (long i = 0; i < n; i++) {
+            cpts[i].node = i;
+            cpts[i].prior = 0.1 + 0.8 * (rng() % 100) / 100.0;
+            for (long j = 0; j < i; j++) {
+                if (rng() % 100 < (i < 8 ? 40u : 25u)) {
+                    cpts[i].addParent(j, 0.05 + 0.9 * (rng() % 100) / 100.0,
+                            (SituationRelation::Relation) (rng() % 3));
+                }
+            }
+        }
+
+        /*
+         * 2. The same evidence sequence on every backend, checked on every node
+         */
+        vector<map<long, long>> rounds(4);
+        for (auto &evidences : rounds) {
+            for (long i = 0; i < n; i++) {
+                if (rng() % 4 == 0) {
+                    evidences[i] = rng() % 2;
+                }
+            }
+        }
+        for (size_t b = 0; b < backends.size(); b++) {
+            InferenceBackend *backend = backends[b].second();
+            backend->BuildNetwork(n, cpts);
+            for (auto &evidences : rounds) {
+                backend->buildSolution(evidences);
+                for (long q = 0; q < n; q++) {
+                    double expected = enumerate(cpts, evidences, q);
+                    if (expected < 0) {
+                        // the evidences are impossible
+                        continue;
+                    }
+                    double p = backend->getProbability(q, 1);
+                    double error = fabs(p - expected);
+                    if (!(error <= 1e-9)) {
+                        cerr << backends[b].first << ": network " << t << ", node " << q
+                                << ": " << p << " instead of " << expected << endl;
+                        return 1;
+                    }
+                    maxErrors[b] = max(maxErrors[b], error);
+                    queries[b]++;
+                }
+            }
+            delete backend;
+        }
+    }
+    for (size_t b = 0; b < backends.size(); b++) {
+        cout << backends[b].first << ": " << queries[b] << " queries, max abs error "
+                << maxErrors[b] << endl;
+    }
+    return 0;
+}
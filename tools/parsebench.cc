@@ -0,0 +1,309 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+/*
+ * Model loading benchmark: compares the streaming (SAX) model parser with the DOM loader
+ * it replaced, which built the whole nlohmann::json document before indexing anything.
+ * Both build the graph up to its layers, i.e., without the reachability index. Every
+ * load runs in a child process, so that its peak resident memory is its own, and both
+ * loaders are first checked to build identical graphs.
+ *
+ * usage: parsebench [model.json | number of situations]...    (default: 10000 100000)
+ * A number stands for a synthetic three-layer model of that size.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <omnetpp.h>
+#include "../src/objects/ModelParser.h"
+#include "../src/objects/SituationGraph.h"
+
+using namespace omnetpp;
+
+static SituationRelation::Relation relationOf(short value) {
+    switch (value) {
+    case 1:
+        return SituationRelation::AND;
+    case 2:
+        return SituationRelation::OR;
+    default:
+        return SituationRelation::SOLE;
+    }
+}
+
+// resolve causes and evidences to dense indices, as SituationGraph::loadModel does
+static void resolve(SituationGraph &sg, const vector<vector<long>> &causeIds,
+        const vector<vector<long>> &evidenceIds) {
+    for (auto &node : sg.nodes) {
+        for (auto cause : causeIds[node.index]) {
+            node.causes.push_back(sg.indexOf(cause));
+        }
+        for (auto evidence : evidenceIds[node.index]) {
+            node.evidences.push_back(sg.indexOf(evidence));
+        }
+    }
+}
+
+/*
+ * The DOM loader of SituationGraph::loadModel before the streaming parser, up to the
+ * layers
+ */
+static void domLoad(SituationGraph &sg, const std::string &filename) {
+    std::ifstream f(filename);
+    json data = json::parse(f);
+    int index = 0;
+    set<long> vertices;
+    set<SituationGraph::edge_id> edges;
+    vector<vector<long>> causeIds;
+    vector<vector<long>> evidenceIds;
+    for (const auto &layer : data["layers"].items()) {
+        std::map<long, int> layerMap;
+        for (const auto &node : layer.value().items()) {
+            SituationNode situation;
+            long id = node.value()["ID"].get<long>();
+            situation.id = id;
+            vertices.insert(id);
+            situation.index = index;
+            situation.layer = sg.layers.size();
+            sg.indexMap[id] = index;
+            causeIds.emplace_back();
+            evidenceIds.emplace_back();
+            index++;
+            situation.duration = SimTime(node.value()["Duration"].get<double>() / 1000.0);
+            situation.type = (SituationInstance::Type) node.value()["type"].get<short>();
+            if (!node.value()["Cycle"].is_null()) {
+                situation.cycle = SimTime(node.value()["Cycle"].get<double>() / 1000.0);
+            }
+            if (!node.value()["Predecessors"].empty()
+                    && !node.value()["Predecessors"].is_null()) {
+                for (const auto &pre : node.value()["Predecessors"].items()) {
+                    SituationRelation relation;
+                    relation.src = pre.value()["ID"].get<long>();
+                    relation.dest = id;
+                    causeIds.back().push_back(relation.src);
+                    relation.type = SituationRelation::H;
+                    relation.relation = relationOf(pre.value()["Relation"].get<short>());
+                    relation.weight = pre.value()["Weight-x"].get<double>();
+                    SituationGraph::edge_id eid(relation.src, id);
+                    sg.relationMap[eid] = relation;
+                    edges.insert(eid);
+                }
+            }
+            if (!node.value()["Children"].empty()
+                    && !node.value()["Children"].is_null()) {
+                for (const auto &chd : node.value()["Children"].items()) {
+                    SituationRelation relation;
+                    relation.src = chd.value()["ID"].get<long>();
+                    relation.dest = id;
+                    evidenceIds.back().push_back(relation.src);
+                    relation.type = SituationRelation::V;
+                    relation.relation = relationOf(chd.value()["Relation"].get<short>());
+                    relation.weight = chd.value()["Weight-y"].get<double>();
+                    SituationGraph::edge_id eid(relation.src, id);
+                    sg.relationMap[eid] = relation;
+                    edges.insert(eid);
+                    edges.insert(SituationGraph::edge_id(id, relation.src));
+                }
+            }
+            layerMap[id] = situation.index;
+            sg.nodes.push_back(situation);
+        }
+        sg.layers.push_back(DirectedGraph());
+        DirectedGraph &graph = sg.layers.back();
+        for (auto m : layerMap) {
+            graph.add_vertex(m.first);
+            for (auto p : causeIds[m.second]) {
+                graph.add_edge(p, m.first);
+            }
+        }
+        graph.finalize();
+    }
+    resolve(sg, causeIds, evidenceIds);
+}
+
+static void saxLoad(SituationGraph &sg, const std::string &filename) {
+    std::ifstream f(filename);
+    ModelParser parser(sg);
+    parser.parse(f, filename);
+    resolve(sg, parser.causeIds, parser.evidenceIds);
+}
+
+static bool sameGraph(const SituationGraph &a, const SituationGraph &b) {
+    if (a.nodes.size() != b.nodes.size() || a.layers.size() != b.layers.size()
+            || a.indexMap != b.indexMap) {
+        return false;
+    }
+    for (size_t i = 0; i < a.nodes.size(); i++) {
+        const SituationNode &x = a.nodes[i];
+        const SituationNode &y = b.nodes[i];
+        if (x.id != y.id || x.index != y.index || x.layer != y.layer
+                || x.type != y.type || x.duration != y.duration
+                || x.cycle != y.cycle || x.causes != y.causes
+                || x.evidences != y.evidences) {
+            return false;
+        }
+    }
+    if (a.relationMap.size() != b.relationMap.size()) {
+        return false;
+    }
+    for (auto x = a.relationMap.begin(), y = b.relationMap.begin();
+            x != a.relationMap.end(); x++, y++) {
+        if (x->first != y->first || x->second.type != y->second.type
+                || x->second.relation != y->second.relation
+                || x->second.weight != y->second.weight) {
+            return false;
+        }
+    }
+    for (size_t l = 0; l < a.layers.size(); l++) {
+        if (a.layers[l].topo_sort() != b.layers[l].topo_sort()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Three layers of 10%, 30% and 60% of the situations. A situation has a cause among
+ * the few before it with probability 0.4, and an upper-layer situation has up to three
+ * evidences in the layer below.
+ */
+static void writeModel(long size, const std::string &filename) {
+    std::mt19937 rng(size);
+    long sizes[] = { size / 10, size * 3 / 10, size - size / 10 - size * 3 / 10 };
+    std::ofstream out(filename);
+    out << "{\"layers\": [";
+    for (int l = 0; l < 3; l++) {
+        long base = (l + 1) * 10000000L;
+        out << (l ? ", [" : "[");
+        for (long k = 0; k < sizes[l]; k++) {
+            out << (k ? ", " : "") << "{\"ID\": " << base + k << ", \"Predecessors\": ";
+            if (k > 0 && rng() % 10 < 4) {
+                long cause = base + k - 1 - rng() % std::min(k, 5L);
+                out << "[{\"ID\": " << cause << ", \"Weight-x\": 0.9, \"Relation\": "
+                        << rng() % 3 << "}]";
+            } else {
+                out << "null";
+            }
+            out << ", \"Children\": ";
+            int numOfChildren = l < 2 ? rng() % 4 : 0;
+            if (numOfChildren > 0) {
+                set<long> children;
+                while ((int) children.size() < std::min<long>(numOfChildren, sizes[l + 1])) {
+                    children.insert(rng() % sizes[l + 1]);
+                }
+                out << "[";
+                for (auto c = children.begin(); c != children.end(); c++) {
+                    out << (c != children.begin() ? ", " : "") << "{\"ID\": "
+                            << (l + 2) * 10000000L + *c
+                            << ", \"Weight-y\": 0.9, \"Relation\": " << 1 + rng() % 2 << "}";
+                }
+                out << "]";
+            } else {
+                out << "null";
+            }
+            out << ", \"Duration\": " << 1000 * (rng() % 4) << ", \"Cycle\": "
+                    << 1000 * (rng() % 2) << ", \"type\": 0}";
+        }
+        out << "]";
+    }
+    out << "]}" << endl;
+}
+
+/*
+ * Run task in a child process and return whether it succeeded
+ */
+template<typename Task>
+static bool inChild(Task task) {
+    cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        int status = 1;
+        try {
+            status = task() ? 0 : 1;
+        } catch (std::exception &e) {
+            cerr << e.what() << endl;
+        }
+        cout.flush();
+        _exit(status);
+    }
+    int status = 0;
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status)
+            && WEXITSTATUS(status) == 0;
+}
+
+static bool measure(const char *name, void (*load)(SituationGraph&, const std::string&),
+        const std::string &filename) {
+    return inChild([&] {
+        auto start = std::chrono::steady_clock::now();
+        SituationGraph sg;
+        load(sg, filename);
+        std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        // ru_maxrss is in kilobytes
+        cout << "  " << name << ": " << elapsed.count() << " ms, peak RSS "
+                << usage.ru_maxrss / 1024 << " MB" << endl;
+        return true;
+    });
+}
+
+int main(int argc, char **argv) {
+    vector<std::string> models;
+    for (int i = 1; i < argc; i++) {
+        models.push_back(argv[i]);
+    }
+    if (models.empty()) {
+        models = { "10000", "100000" };
+    }
+
+    for (auto &model : models) {
+        std::string filename = model;
+        bool synthetic = model.find_first_not_of("0123456789") == std::string::npos;
+        if (synthetic) {
+            filename = "parsebench-" + model + ".json";
+            writeModel(atol(model.c_str()), filename);
+        }
+        bool ok = inChild([&] {
+            SituationGraph dom, sax;
+            domLoad(dom, filename);
+            saxLoad(sax, filename);
+            cout << filename << ": " << sax.nodes.size() << " situations, "
+                    << sax.relationMap.size() << " relations" << endl;
+            if (!sameGraph(dom, sax)) {
+                cerr << filename << ": the DOM and SAX loaders build different graphs" << endl;
+                return false;
+            }
+            return true;
+        });
+        ok = ok && measure("DOM", domLoad, filename) && measure("SAX", saxLoad, filename);
+        if (synthetic) {
+            remove(filename.c_str());
+        }
+        if (!ok) {
+            return 1;
+        }
+    }
+    return 0;
+}
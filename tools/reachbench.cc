@@ -0,0 +1,116 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+/*
+ * Reachability benchmark: times ReachabilityIndex::build on random situation-like
+ * graphs and checks the closure against a breadth-first search first.
+ *
+ * usage: reachbench [vertices...]    (default: 1000 10000 50000)
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <queue>
+#include <random>
+#include "../src/objects/ReachabilityIndex.h"
+
+/*
+ * Compare the closure of small random graphs, cycles and self-loops included,
+ * with a breadth-first search from every vertex
+ */
+static bool check(std::mt19937 &rng) {
+    for (int t = 0; t < 200; t++) {
+        int n = 1 + rng() % 60;
+        int m = rng() % (3 * n);
+        vector<pair<int, int>> edges;
+        vector<vector<int>> adj(n);
+        for (int k = 0; k < m; k++) {
+            int u = rng() % n;
+            int v = rng() % n;
+            edges.push_back(make_pair(u, v));
+            if (u != v) {
+                adj[u].push_back(v);
+            }
+        }
+        ReachabilityIndex ri;
+        ri.build(n, edges);
+        for (int s = 0; s < n; s++) {
+            vector<char> visited(n, 0);
+            queue<int> q;
+            q.push(s);
+            while (!q.empty()) {
+                int u = q.front();
+                q.pop();
+                for (auto v : adj[u]) {
+                    if (!visited[v]) {
+                        visited[v] = 1;
+                        q.push(v);
+                    }
+                }
+            }
+            for (int d = 0; d < n; d++) {
+                if ((bool) visited[d] != ri.reachable(s, d)) {
+                    cerr << "graph " << t << ": reachable(" << s << ", " << d
+                            << ") differs from BFS" << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::mt19937 rng(1);
+    if (!check(rng)) {
+        return 1;
+    }
+    vector<int> sizes;
+    for (int i = 1; i < argc; i++) {
+        sizes.push_back(atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = { 1000, 10000, 50000 };
+    }
+
+    for (auto n : sizes) {
+        /*
+         * About three causes per situation, towards lower indices so that causes
+         * stay acyclic, plus bidirectional evidence relations on a tenth of them
+         */
+        vector<pair<int, int>> edges;
+        for (int v = 1; v < n; v++) {
+            for (int k = 0; k < 3; k++) {
+                edges.push_back(make_pair((int) (rng() % v), v));
+            }
+        }
+        for (int v = 0; v < n / 10; v++) {
+            int parent = n / 10 + rng() % (n - n / 10);
+            edges.push_back(make_pair(parent, v));
+            edges.push_back(make_pair(v, parent));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ReachabilityIndex ri;
+        ri.build(n, edges);
+        std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+        cout << n << " vertices, " << edges.size() << " edges: build "
+                << elapsed.count() << " ms" << endl;
+    }
+    return 0;
+}
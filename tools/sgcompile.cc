@@ -0,0 +1,52 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+/*
+ * Model compiler: compiles situation graph models into the binary images that
+ * ModelRegistry loads in place of the JSON models.
+ *
+ * usage: sgcompile model.json...
+ */
+
+#include <iostream>
+#include <omnetpp.h>
+#include "../src/objects/SituationGraph.h"
+#include "../src/objects/ModelImage.h"
+
+using namespace omnetpp;
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " model.json..." << endl;
+        return 1;
+    }
+    // default simulation time resolution (picoseconds) for durations and cycles
+    SimTime::setScaleExp(-12);
+    for (int i = 1; i < argc; i++) {
+        std::string model = argv[i];
+        std::string image = ModelImage::imagePathOf(model);
+        try {
+            SituationGraph sg;
+            sg.loadModel(model);
+            ModelImage::save(sg, model, image);
+        } catch (const std::exception &e) {
+            cerr << model << ": " << e.what() << endl;
+            return 1;
+        }
+        cout << model << " -> " << image << endl;
+    }
+    return 0;
+}